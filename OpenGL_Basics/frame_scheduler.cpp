@@ -0,0 +1,221 @@
+#include <frame_scheduler.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <thread>
+
+SchedulerOptions SchedulerOptions::parse(int argc, char** argv, bool headless) {
+	SchedulerOptions options;
+	options.swapMode = SwapMode::Vsync;
+	options.fpsCap = 0.0;
+	options.justInTimeInput = false;
+	// nothing presents offscreen frames, so keep one in flight instead of finishing each
+	options.framesInFlight = headless ? 1 : 0;
+	options.offscreen = headless;
+	options.pollEvents = true;
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		if (arg == "--vsync" && i + 1 < argc) {
+			std::string mode = argv[++i];
+			if (mode == "off") {
+				options.swapMode = SwapMode::Off;
+			} else if (mode == "adaptive") {
+				options.swapMode = SwapMode::Adaptive;
+			} else if (mode == "on") {
+				options.swapMode = SwapMode::Vsync;
+			} else {
+				std::cerr << "Invalid --vsync " << mode << ", expected on, off or adaptive" << std::endl;
+			}
+		} else if (arg == "--fps-cap" && i + 1 < argc) {
+			options.fpsCap = std::max(0.0, std::atof(argv[++i]));
+		} else if (arg == "--jit-input") {
+			options.justInTimeInput = true;
+		} else if (arg == "--frames-in-flight" && i + 1 < argc) {
+			options.framesInFlight = std::min(std::max(0, std::atoi(argv[++i])), 7);
+		}
+	}
+	return options;
+}
+
+std::string SchedulerOptions::describe() const {
+	std::string label = offscreen ? "offscreen" : swapMode == SwapMode::Off ? "vsync off" : swapMode == SwapMode::Adaptive ? "adaptive vsync" : "vsync";
+	if (fpsCap > 0.0) {
+		label += ", cap " + std::to_string((int)fpsCap);
+	}
+	if (justInTimeInput) {
+		label += ", jit input";
+	}
+	if (framesInFlight > 0) {
+		label += ", " + std::to_string(framesInFlight) + " in flight";
+	}
+	return label;
+}
+
+FrameScheduler::FrameScheduler(const SchedulerOptions& options, FrameStats& frameStats)
+	: options(options), frameStats(frameStats), window(nullptr), slots(), frameIndex(0), framePeriod(0),
+	recentWorkMs(), recentWorkCount(0), spinMarginMs(1.0), gpuClockOffset(0), timestampsSupported(false) {
+}
+
+void FrameScheduler::create(GLFWwindow* targetWindow) {
+	window = targetWindow;
+	if (window != nullptr) {
+		int interval = options.swapMode == SwapMode::Off ? 0 : 1;
+		if (options.swapMode == SwapMode::Adaptive) {
+			if (glfwExtensionSupported("WGL_EXT_swap_control_tear") || glfwExtensionSupported("GLX_EXT_swap_control_tear")) {
+				interval = -1;
+			} else {
+				std::cerr << "Adaptive vsync is not supported here, using vsync" << std::endl;
+			}
+		}
+		glfwSwapInterval(interval);
+	}
+
+	// the frame period deadlines are measured in; offscreen frames only have the cap
+	double targetFps = options.fpsCap;
+	if (targetFps <= 0.0 && options.swapMode != SwapMode::Off && window != nullptr) {
+		const GLFWvidmode* mode = glfwGetVideoMode(glfwGetPrimaryMonitor());
+		targetFps = mode != nullptr ? mode->refreshRate : 60.0;
+	}
+	if (targetFps > 0.0) {
+		framePeriod = std::chrono::nanoseconds((long long)(1e9 / targetFps));
+	}
+
+	int timestampBits = 0;
+	glGetQueryiv(GL_TIMESTAMP, GL_QUERY_COUNTER_BITS, &timestampBits);
+	timestampsSupported = timestampBits > 0;
+	for (FrameSlot& slot : slots) {
+		slot.fence = nullptr;
+		slot.timestampQuery = 0;
+		if (timestampsSupported) {
+			glGenQueries(1, &slot.timestampQuery);
+		}
+	}
+	calibrateClock();
+	std::cout << "Frame pacing: " << options.describe() << std::endl;
+
+	nextDeadline = std::chrono::steady_clock::now();
+	lastPresent = nextDeadline;
+}
+
+void FrameScheduler::beginFrame() {
+	// at most K frames queued: wait for the one submitted K frames ago
+	if (options.framesInFlight > 0 && frameIndex >= (unsigned long)options.framesInFlight) {
+		resolveSlot(slots[(frameIndex - options.framesInFlight) % SLOT_COUNT], true);
+	}
+
+	// when this frame should be presented: the next cap deadline, or one refresh after the last swap
+	std::chrono::steady_clock::time_point due;
+	bool hasDeadline = framePeriod.count() > 0;
+	if (options.fpsCap > 0.0) {
+		// deadlines advance by whole periods, but a late frame resets them instead of bursting to catch up
+		nextDeadline = std::max(nextDeadline + framePeriod, std::chrono::steady_clock::now());
+		due = nextDeadline;
+	} else {
+		due = lastPresent + framePeriod;
+	}
+
+	if (options.justInTimeInput && hasDeadline) {
+		// poll only as early as the slowest recent frame needs, plus a millisecond of slack
+		double workMs = recentWorkCount == 0 ? 0.0 : *std::max_element(recentWorkMs, recentWorkMs + std::min<unsigned long>(recentWorkCount, WORK_WINDOW));
+		waitUntil(due - std::chrono::nanoseconds((long long)((workMs + 1.0) * 1e6)));
+	} else if (options.fpsCap > 0.0) {
+		waitUntil(due);
+	}
+
+	inputTime = std::chrono::steady_clock::now();
+	if (window != nullptr && options.pollEvents) {
+		glfwPollEvents();
+	}
+}
+
+void FrameScheduler::present() {
+	FrameSlot& slot = slots[frameIndex % SLOT_COUNT];
+	// the slot is reused every SLOT_COUNT frames; collect what it still holds
+	resolveSlot(slot, true);
+	if (timestampsSupported) {
+		glQueryCounter(slot.timestampQuery, GL_TIMESTAMP);
+	}
+	slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	slot.inputTime = inputTime;
+
+	auto submitted = std::chrono::steady_clock::now();
+	recentWorkMs[recentWorkCount % WORK_WINDOW] = std::chrono::duration<double, std::milli>(submitted - inputTime).count();
+	++recentWorkCount;
+
+	if (window != nullptr) {
+		glfwSwapBuffers(window);
+	} else {
+		glFlush();
+	}
+	lastPresent = std::chrono::steady_clock::now();
+
+	// pick up any finished frames without blocking
+	for (FrameSlot& pending : slots) {
+		resolveSlot(pending, false);
+	}
+	if (++frameIndex % 120 == 0) {
+		calibrateClock();
+	}
+}
+
+void FrameScheduler::destroy() {
+	for (FrameSlot& slot : slots) {
+		resolveSlot(slot, true);
+		if (slot.timestampQuery != 0) {
+			glDeleteQueries(1, &slot.timestampQuery);
+			slot.timestampQuery = 0;
+		}
+	}
+}
+
+void FrameScheduler::waitUntil(std::chrono::steady_clock::time_point target) {
+	auto now = std::chrono::steady_clock::now();
+	double remainingMs = std::chrono::duration<double, std::milli>(target - now).count();
+	if (remainingMs > spinMarginMs) {
+		auto requested = std::chrono::duration<double, std::milli>(remainingMs - spinMarginMs);
+		std::this_thread::sleep_for(requested);
+		// widen the spin when sleeps overshoot (coarse OS timers), narrow it slowly otherwise
+		double overshootMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - now).count() - requested.count();
+		spinMarginMs = overshootMs * 1.5 > spinMarginMs ? overshootMs * 1.5 : spinMarginMs * 0.99;
+		spinMarginMs = std::min(std::max(spinMarginMs, 0.25), 20.0);
+	}
+	while (std::chrono::steady_clock::now() < target) {
+		std::this_thread::yield();
+	}
+}
+
+void FrameScheduler::resolveSlot(FrameSlot& slot, bool wait) {
+	if (slot.fence == nullptr) {
+		return;
+	}
+	GLenum status = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, wait ? 1000000000ull : 0);
+	if (status == GL_TIMEOUT_EXPIRED && wait) {
+		// a second is far past any frame; drop the sample rather than hang
+		std::cerr << "Frame fence timed out" << std::endl;
+	} else if (status == GL_TIMEOUT_EXPIRED) {
+		return;
+	}
+	glDeleteSync(slot.fence);
+	slot.fence = nullptr;
+
+	if (timestampsSupported && status != GL_TIMEOUT_EXPIRED && status != GL_WAIT_FAILED) {
+		GLuint64 gpuTime = 0;
+		glGetQueryObjectui64v(slot.timestampQuery, GL_QUERY_RESULT, &gpuTime);
+		long long inputNs = std::chrono::duration_cast<std::chrono::nanoseconds>(slot.inputTime.time_since_epoch()).count();
+		double latencyMs = ((long long)gpuTime - gpuClockOffset - inputNs) / 1e6;
+		frameStats.addLatency(latencyMs);
+	}
+}
+
+void FrameScheduler::calibrateClock() {
+	if (!timestampsSupported) {
+		return;
+	}
+	// GL_TIMESTAMP read directly is the GPU clock now; pair it with the CPU clock around the call
+	auto before = std::chrono::steady_clock::now();
+	GLint64 gpuNow = 0;
+	glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+	auto after = std::chrono::steady_clock::now();
+	long long cpuNs = std::chrono::duration_cast<std::chrono::nanoseconds>((before + (after - before) / 2).time_since_epoch()).count();
+	gpuClockOffset = gpuNow - cpuNs;
+}
@@ -0,0 +1,148 @@
+#include <frame_stats.hpp>
+
+#include <glad/glad.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+// initialized before main runs, so close enough to process start
+static const std::chrono::steady_clock::time_point processStart = std::chrono::steady_clock::now();
+
+static double getPeakResidentKb() {
+#if defined(_WIN32)
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+		return counters.PeakWorkingSetSize / 1024.0;
+	}
+	return 0.0;
+#else
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+	return usage.ru_maxrss / 1024.0;
+#else
+	return (double)usage.ru_maxrss;
+#endif
+#endif
+}
+
+FrameStats::FrameStats() : startupMs(0.0), drawCalls(0) {}
+
+void FrameStats::reserve(size_t frameCount) {
+	frameMs.reserve(frameCount);
+	latencyMs.reserve(frameCount);
+}
+
+void FrameStats::beginFrame() {
+	frameStart = std::chrono::steady_clock::now();
+	if (frameMs.empty()) {
+		startupMs = std::chrono::duration<double, std::milli>(frameStart - processStart).count();
+	}
+}
+
+void FrameStats::endFrame() {
+	frameMs.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count());
+}
+
+void FrameStats::addDrawCalls(int count) {
+	drawCalls += count;
+}
+
+void FrameStats::addLatency(double ms) {
+	latencyMs.push_back(ms);
+}
+
+void FrameStats::setPacing(const std::string& description) {
+	pacing = description;
+}
+
+// mean, spread and nearest-rank percentiles of one series, as a JSON object
+static std::string summarize(const std::vector<double>& samples, double& total) {
+	std::vector<double> sorted = samples;
+	std::sort(sorted.begin(), sorted.end());
+	size_t count = sorted.size();
+	total = 0.0;
+	for (double ms : sorted) {
+		total += ms;
+	}
+	double mean = count > 0 ? total / count : 0.0;
+	double variance = 0.0;
+	for (double ms : sorted) {
+		variance += (ms - mean) * (ms - mean);
+	}
+	variance = count > 1 ? variance / (count - 1) : 0.0;
+	auto percentile = [&](double p) {
+		if (count == 0) {
+			return 0.0;
+		}
+		size_t rank = (size_t)std::ceil(p / 100.0 * count);
+		return sorted[std::min(count - 1, rank > 0 ? rank - 1 : 0)];
+	};
+
+	std::ostringstream json;
+	json << "{\n"
+		<< "    \"mean\": " << mean << ",\n"
+		<< "    \"stddev\": " << std::sqrt(variance) << ",\n"
+		<< "    \"variance\": " << variance << ",\n"
+		<< "    \"min\": " << (count > 0 ? sorted.front() : 0.0) << ",\n"
+		<< "    \"median\": " << percentile(50.0) << ",\n"
+		<< "    \"p95\": " << percentile(95.0) << ",\n"
+		<< "    \"p99\": " << percentile(99.0) << ",\n"
+		<< "    \"max\": " << (count > 0 ? sorted.back() : 0.0) << "\n"
+		<< "  }";
+	return json.str();
+}
+
+void FrameStats::writeReport(const std::string& demoName, int width, int height, const std::string& path) const {
+	double total = 0.0, latencyTotal = 0.0;
+	std::string frameSummary = summarize(frameMs, total);
+	std::string latencySummary = summarize(latencyMs, latencyTotal);
+	size_t count = frameMs.size();
+	const char* renderer = (const char*)glGetString(GL_RENDERER);
+
+	std::ostringstream json;
+	json << "{\n"
+		<< "  \"demo\": \"" << demoName << "\",\n"
+		<< "  \"renderer\": \"" << (renderer ? renderer : "unknown") << "\",\n"
+		<< "  \"pacing\": \"" << pacing << "\",\n"
+		<< "  \"width\": " << width << ",\n"
+		<< "  \"height\": " << height << ",\n"
+		<< "  \"frames\": " << count << ",\n"
+		<< "  \"total_ms\": " << total << ",\n"
+		<< "  \"fps\": " << (total > 0.0 ? count * 1000.0 / total : 0.0) << ",\n"
+		<< "  \"startup_ms\": " << startupMs << ",\n"
+		<< "  \"draw_calls_per_frame\": " << (count > 0 ? (double)drawCalls / count : 0.0) << ",\n"
+		<< "  \"peak_rss_kb\": " << getPeakResidentKb() << ",\n"
+		<< "  \"frame_ms\": " << frameSummary << ",\n"
+		<< "  \"latency_samples\": " << latencyMs.size() << ",\n"
+		<< "  \"latency_ms\": " << latencySummary;
+
+	if (path.empty()) {
+		std::cout << json.str() << "\n}\n";
+		return;
+	}
+	json << ",\n  \"frame_samples_ms\": [";
+	for (size_t i = 0; i < frameMs.size(); ++i) {
+		json << (i > 0 ? ", " : "") << frameMs[i];
+	}
+	json << "]\n}\n";
+	std::ofstream file(path);
+	if (!file) {
+		std::cerr << "Failed to write report: " << path << std::endl;
+		return;
+	}
+	file << json.str();
+	std::cout << "Frame report written to " << path << std::endl;
+}
+
+size_t FrameStats::getFrameCount() const {
+	return frameMs.size();
+}
@@ -0,0 +1,287 @@
+#include <gl_debug.hpp>
+
+#ifdef GL_DEBUG_LAYER
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+GlDebugOptions GlDebugOptions::parse(int argc, char** argv) {
+	GlDebugOptions options;
+	options.notifications = false;
+	options.printLimit = 8;
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		if (arg == "--gl-debug-notifications") {
+			options.notifications = true;
+		} else if (arg == "--gl-debug-limit" && i + 1 < argc) {
+			options.printLimit = std::max(0, std::atoi(argv[++i]));
+		}
+	}
+	return options;
+}
+
+namespace {
+	// one distinct message: same source, type, id, severity, zone and text
+	struct Message {
+		GLenum source;
+		GLenum type;
+		GLenum severity;
+		GLuint id;
+		const char* zone;
+		std::string object;
+		std::string text;
+		size_t count;
+		int firstFrame;
+	};
+
+	struct State {
+		GlDebugOptions options = { false, 8 };
+		bool installed = false;
+		const char* zones[GlDebug::MAX_ZONE_DEPTH] = {};
+		// whether the zone was also pushed as a debug group, which needs install() first
+		bool grouped[GlDebug::MAX_ZONE_DEPTH] = {};
+		int zoneDepth = 0;
+		std::unordered_map<uint64_t, std::string> labels;
+		std::unordered_map<size_t, size_t> messageIndex;
+		std::vector<Message> messages;
+		int frame = 0;
+		size_t frameMessages = 0;
+		int framePrinted = 0;
+		size_t errors = 0;
+		size_t performance = 0;
+		size_t other = 0;
+		size_t unprinted = 0;
+		size_t busiestFrame = 0;
+		int framesWithMessages = 0;
+	};
+
+	State& getState() {
+		static State state;
+		return state;
+	}
+
+	const char* getSourceName(GLenum source) {
+		switch (source) {
+		case GL_DEBUG_SOURCE_API: return "api";
+		case GL_DEBUG_SOURCE_WINDOW_SYSTEM: return "window system";
+		case GL_DEBUG_SOURCE_SHADER_COMPILER: return "shader compiler";
+		case GL_DEBUG_SOURCE_THIRD_PARTY: return "third party";
+		case GL_DEBUG_SOURCE_APPLICATION: return "application";
+		default: return "other";
+		}
+	}
+
+	const char* getTypeName(GLenum type) {
+		switch (type) {
+		case GL_DEBUG_TYPE_ERROR: return "error";
+		case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR: return "deprecated";
+		case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR: return "undefined behavior";
+		case GL_DEBUG_TYPE_PORTABILITY: return "portability";
+		case GL_DEBUG_TYPE_PERFORMANCE: return "performance";
+		case GL_DEBUG_TYPE_MARKER: return "marker";
+		default: return "other";
+		}
+	}
+
+	const char* getSeverityName(GLenum severity) {
+		switch (severity) {
+		case GL_DEBUG_SEVERITY_HIGH: return "high";
+		case GL_DEBUG_SEVERITY_MEDIUM: return "medium";
+		case GL_DEBUG_SEVERITY_LOW: return "low";
+		default: return "notification";
+		}
+	}
+
+	// Drivers name objects by number, "buffer 3", "texture object 5", "program 7";
+	// the first one that was labelled names the message
+	std::string findObject(std::string_view text) {
+		static const struct {
+			const char* word;
+			GLenum identifier;
+		} KINDS[] = {
+			{ "framebuffer", GL_FRAMEBUFFER },
+			{ "renderbuffer", GL_RENDERBUFFER },
+			{ "vertex array", GL_VERTEX_ARRAY },
+			{ "buffer", GL_BUFFER },
+			{ "texture", GL_TEXTURE },
+			{ "program", GL_PROGRAM },
+			{ "shader", GL_SHADER }
+		};
+		State& state = getState();
+		std::string lower(text);
+		std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+		for (const auto& kind : KINDS) {
+			size_t length = std::strlen(kind.word);
+			for (size_t at = lower.find(kind.word); at != std::string::npos; at = lower.find(kind.word, at + 1)) {
+				// whole words only, so "buffer" does not match inside "framebuffer"
+				if (at > 0 && std::isalpha((unsigned char)lower[at - 1])) {
+					continue;
+				}
+				size_t cursor = at + length;
+				for (;;) {
+					if (lower.compare(cursor, 6, "object") == 0) {
+						cursor += 6;
+					} else if (cursor < lower.size() && (lower[cursor] == ' ' || lower[cursor] == '#')) {
+						++cursor;
+					} else {
+						break;
+					}
+				}
+				if (cursor >= lower.size() || !std::isdigit((unsigned char)lower[cursor])) {
+					continue;
+				}
+				GLuint name = (GLuint)std::strtoul(lower.c_str() + cursor, nullptr, 10);
+				auto found = state.labels.find(((uint64_t)kind.identifier << 32) | name);
+				if (found != state.labels.end()) {
+					return found->second;
+				}
+			}
+		}
+		return std::string();
+	}
+
+	void APIENTRY onMessage(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* message, const void*) {
+		State& state = getState();
+		std::string_view text(message, length >= 0 ? (size_t)length : std::strlen(message));
+		const char* zone = state.zoneDepth > 0 ? state.zones[std::min(state.zoneDepth, (int)GlDebug::MAX_ZONE_DEPTH) - 1] : "no zone";
+
+		if (type == GL_DEBUG_TYPE_ERROR) {
+			++state.errors;
+		} else if (type == GL_DEBUG_TYPE_PERFORMANCE) {
+			++state.performance;
+		} else {
+			++state.other;
+		}
+		++state.frameMessages;
+
+		// repeats are looked up without allocating; only a new message is copied
+		size_t key = std::hash<std::string_view>()(text);
+		for (size_t value : { (size_t)source, (size_t)type, (size_t)id, (size_t)severity, (size_t)(uintptr_t)zone }) {
+			key = key * 1000003 ^ value;
+		}
+		// a hit is only a repeat when everything matches; a colliding message probes on to the next key
+		for (auto found = state.messageIndex.find(key); found != state.messageIndex.end(); found = state.messageIndex.find(++key)) {
+			Message& seen = state.messages[found->second];
+			if (seen.source == source && seen.type == type && seen.id == id && seen.severity == severity && seen.zone == zone && seen.text == text) {
+				++seen.count;
+				return;
+			}
+		}
+		state.messageIndex[key] = state.messages.size();
+		state.messages.push_back({ source, type, severity, id, zone, findObject(text), std::string(text), 1, state.frame });
+		const Message& entry = state.messages.back();
+		if (state.framePrinted >= state.options.printLimit) {
+			++state.unprinted;
+			return;
+		}
+		++state.framePrinted;
+		std::fprintf(stderr, "GL debug [frame %d, %s%s%s] %s %s (%s, id %u): %s\n", state.frame, zone,
+			entry.object.empty() ? "" : ", ", entry.object.c_str(), getSeverityName(severity), getTypeName(type),
+			getSourceName(source), id, entry.text.c_str());
+	}
+}
+
+bool GlDebug::wantsDebugContext() {
+	return true;
+}
+
+void GlDebug::install(const GlDebugOptions& options) {
+	State& state = getState();
+	state.options = options;
+	if (glDebugMessageCallback == nullptr) {
+		std::fprintf(stderr, "GL debug: KHR_debug is not available, messages are not captured\n");
+		return;
+	}
+	GLint flags = 0;
+	glGetIntegerv(GL_CONTEXT_FLAGS, &flags);
+	glEnable(GL_DEBUG_OUTPUT);
+	// the callback runs inside the offending call, on this thread, so the zone is the right one
+	glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+	glDebugMessageCallback(onMessage, nullptr);
+	glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, nullptr, GL_TRUE);
+	if (!options.notifications) {
+		glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION, 0, nullptr, GL_FALSE);
+	}
+	// our own zones would come back as group messages
+	glDebugMessageControl(GL_DEBUG_SOURCE_APPLICATION, GL_DEBUG_TYPE_PUSH_GROUP, GL_DONT_CARE, 0, nullptr, GL_FALSE);
+	glDebugMessageControl(GL_DEBUG_SOURCE_APPLICATION, GL_DEBUG_TYPE_POP_GROUP, GL_DONT_CARE, 0, nullptr, GL_FALSE);
+	state.installed = true;
+	std::printf("GL debug: capturing messages in a %s context, at most %d printed a frame\n",
+		(flags & GL_CONTEXT_FLAG_DEBUG_BIT) != 0 ? "debug" : "non-debug (errors only on most drivers)", options.printLimit);
+}
+
+void GlDebug::label(GLenum identifier, GLuint name, const char* text) {
+	// not loaded when there is no context, as in the micro benchmarks
+	if (name == 0 || glObjectLabel == nullptr) {
+		return;
+	}
+	glObjectLabel(identifier, name, -1, text);
+	getState().labels[((uint64_t)identifier << 32) | name] = text;
+}
+
+void GlDebug::pushZone(const char* name) {
+	State& state = getState();
+	if (state.zoneDepth < MAX_ZONE_DEPTH) {
+		state.zones[state.zoneDepth] = name;
+		state.grouped[state.zoneDepth] = state.installed;
+		if (state.installed) {
+			glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, name);
+		}
+	}
+	++state.zoneDepth;
+}
+
+void GlDebug::popZone() {
+	State& state = getState();
+	if (state.zoneDepth == 0) {
+		return;
+	}
+	--state.zoneDepth;
+	if (state.zoneDepth < MAX_ZONE_DEPTH && state.grouped[state.zoneDepth]) {
+		glPopDebugGroup();
+	}
+}
+
+void GlDebug::endFrame() {
+	State& state = getState();
+	if (state.frameMessages > 0) {
+		++state.framesWithMessages;
+		state.busiestFrame = std::max(state.busiestFrame, state.frameMessages);
+	}
+	state.frameMessages = 0;
+	state.framePrinted = 0;
+	++state.frame;
+}
+
+void GlDebug::report() {
+	State& state = getState();
+	if (!state.installed) {
+		return;
+	}
+	std::printf("GL debug: %zu messages (%zu errors, %zu performance, %zu other), %zu distinct, in %d of %d frames, at most %zu in one frame, %zu not printed\n",
+		state.errors + state.performance + state.other, state.errors, state.performance, state.other, state.messages.size(),
+		state.framesWithMessages, state.frame, state.busiestFrame, state.unprinted);
+	std::vector<const Message*> sorted;
+	for (const Message& message : state.messages) {
+		sorted.push_back(&message);
+	}
+	std::stable_sort(sorted.begin(), sorted.end(), [](const Message* a, const Message* b) { return a->count > b->count; });
+	for (size_t i = 0; i < sorted.size() && i < (size_t)REPORT_TOP; ++i) {
+		const Message& message = *sorted[i];
+		// long shader logs are cut to their first line
+		std::string text = message.text.substr(0, message.text.find('\n'));
+		std::printf("  %6zux %s %s [%s%s%s] from frame %d: %.160s\n", message.count, getSeverityName(message.severity),
+			getTypeName(message.type), message.zone, message.object.empty() ? "" : ", ", message.object.c_str(),
+			message.firstFrame, text.c_str());
+	}
+}
+
+#endif
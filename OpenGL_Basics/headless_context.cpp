@@ -0,0 +1,252 @@
+#include <headless_context.hpp>
+#include <gl_debug.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#if defined(__linux__)
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#define HEADLESS_EGL
+#endif
+
+HeadlessOptions HeadlessOptions::parse(int argc, char** argv, int defaultWidth, int defaultHeight) {
+	HeadlessOptions options;
+	options.enabled = false;
+	options.frames = 300;
+	options.width = defaultWidth;
+	options.height = defaultHeight;
+	options.dumpEvery = 1;
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		if (arg == "--headless") {
+			options.enabled = true;
+		} else if (arg == "--frames" && i + 1 < argc) {
+			options.frames = std::stoi(argv[++i]);
+		} else if (arg == "--size" && i + 1 < argc) {
+			int width = 0, height = 0;
+			if (std::sscanf(argv[++i], "%dx%d", &width, &height) == 2 && width > 0 && height > 0) {
+				options.width = width;
+				options.height = height;
+			} else {
+				std::cerr << "Invalid --size " << argv[i] << ", expected WxH" << std::endl;
+			}
+		} else if (arg == "--dump" && i + 1 < argc) {
+			options.dumpDirectory = argv[++i];
+		} else if (arg == "--dump-every" && i + 1 < argc) {
+			options.dumpEvery = std::max(1, std::stoi(argv[++i]));
+		} else if (arg == "--report" && i + 1 < argc) {
+			options.reportPath = argv[++i];
+		}
+	}
+	return options;
+}
+
+HeadlessContext::HeadlessContext(const HeadlessOptions& options)
+	: options(options), display(nullptr), context(nullptr), hiddenWindow(nullptr),
+	framebuffer(0), colorBuffer(0), depthBuffer(0) {
+}
+
+bool HeadlessContext::create() {
+	if (!createContext()) {
+		return false;
+	}
+
+	glGenFramebuffers(1, &framebuffer);
+	glGenRenderbuffers(1, &colorBuffer);
+	glGenRenderbuffers(1, &depthBuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, options.width, options.height);
+	GlDebug::label(GL_RENDERBUFFER, colorBuffer, "headless color");
+	glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, options.width, options.height);
+	GlDebug::label(GL_RENDERBUFFER, depthBuffer, "headless depth stencil");
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	GlDebug::label(GL_FRAMEBUFFER, framebuffer, "headless");
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+		std::cerr << "Headless framebuffer incomplete" << std::endl;
+		destroy();
+		return false;
+	}
+	glViewport(0, 0, options.width, options.height);
+	std::cout << "Headless: " << options.width << "x" << options.height << ", " << options.frames
+		<< " frames on " << glGetString(GL_RENDERER) << std::endl;
+	return true;
+}
+
+void HeadlessContext::beginFrame() {
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	glViewport(0, 0, options.width, options.height);
+}
+
+void HeadlessContext::endFrame(int frame) {
+	// the frame scheduler's fences pace offscreen frames; glReadPixels syncs its own
+	if (!options.dumpDirectory.empty() && frame % options.dumpEvery == 0) {
+		char name[32];
+		std::snprintf(name, sizeof(name), "/frame_%05d.ppm", frame);
+		dumpFrame(options.dumpDirectory + name);
+	}
+}
+
+bool HeadlessContext::dumpFrame(const std::string& path) const {
+	std::vector<unsigned char> pixels((size_t)options.width * options.height * 3);
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(0, 0, options.width, options.height, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+
+	FILE* file = std::fopen(path.c_str(), "wb");
+	if (file == nullptr) {
+		std::cerr << "Failed to write frame: " << path << std::endl;
+		return false;
+	}
+	std::fprintf(file, "P6\n%d %d\n255\n", options.width, options.height);
+	// GL rows run bottom to top, PPM rows top to bottom
+	size_t rowSize = (size_t)options.width * 3;
+	for (int row = options.height - 1; row >= 0; --row) {
+		std::fwrite(&pixels[row * rowSize], 1, rowSize, file);
+	}
+	std::fclose(file);
+	return true;
+}
+
+void HeadlessContext::destroy() {
+	if (framebuffer != 0) {
+		glDeleteFramebuffers(1, &framebuffer);
+		glDeleteRenderbuffers(1, &colorBuffer);
+		glDeleteRenderbuffers(1, &depthBuffer);
+		framebuffer = 0;
+	}
+	destroyContext();
+}
+
+float HeadlessContext::getFrameTime(int frame) {
+	return frame / 60.0f;
+}
+
+#ifdef HEADLESS_EGL
+bool HeadlessContext::createContext() {
+	// prefer a display that needs no window system at all
+	EGLDisplay eglDisplay = EGL_NO_DISPLAY;
+	PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+		(PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+	if (getPlatformDisplay != nullptr) {
+		eglDisplay = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+	}
+	if (eglDisplay == EGL_NO_DISPLAY) {
+		eglDisplay = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+	}
+	if (eglDisplay == EGL_NO_DISPLAY || !eglInitialize(eglDisplay, nullptr, nullptr)) {
+		std::cerr << "EGL initialization failed" << std::endl;
+		return false;
+	}
+	display = eglDisplay;
+	if (!eglBindAPI(EGL_OPENGL_API)) {
+		std::cerr << "EGL has no desktop OpenGL" << std::endl;
+		destroyContext();
+		return false;
+	}
+
+	// the default surface type is window, which a surfaceless display has none of
+	const EGLint configAttributes[] = { EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE };
+	EGLConfig config;
+	EGLint configCount = 0;
+	if (!eglChooseConfig(eglDisplay, configAttributes, &config, 1, &configCount) || configCount == 0) {
+		std::cerr << "EGL found no OpenGL config" << std::endl;
+		destroyContext();
+		return false;
+	}
+	const EGLint contextAttributes[] = {
+		EGL_CONTEXT_MAJOR_VERSION, 4,
+		EGL_CONTEXT_MINOR_VERSION, 6,
+		EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+		EGL_CONTEXT_OPENGL_DEBUG, GlDebug::wantsDebugContext() ? EGL_TRUE : EGL_FALSE,
+		EGL_NONE
+	};
+	EGLContext eglContext = eglCreateContext(eglDisplay, config, EGL_NO_CONTEXT, contextAttributes);
+	if (eglContext == EGL_NO_CONTEXT) {
+		// llvmpipe before Mesa 23.1 reports 4.5 but runs the demos with
+		// MESA_GL_VERSION_OVERRIDE=4.6 MESA_GLSL_VERSION_OVERRIDE=460
+		std::cerr << "EGL OpenGL 4.6 core context creation failed" << std::endl;
+		destroyContext();
+		return false;
+	}
+	context = eglContext;
+	// surfaceless: everything is drawn into our own framebuffer
+	if (!eglMakeCurrent(eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, eglContext)) {
+		std::cerr << "EGL surfaceless context not supported" << std::endl;
+		destroyContext();
+		return false;
+	}
+	if (!gladLoadGLLoader((GLADloadproc)eglGetProcAddress)) {
+		std::cerr << "GLAD initialization failed" << std::endl;
+		destroyContext();
+		return false;
+	}
+	return true;
+}
+
+void HeadlessContext::destroyContext() {
+	if (display == nullptr) {
+		return;
+	}
+	eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+	if (context != nullptr) {
+		eglDestroyContext(display, context);
+		context = nullptr;
+	}
+	eglTerminate(display);
+	display = nullptr;
+}
+
+bool HeadlessContext::makeCurrent() {
+	return eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context) == EGL_TRUE;
+}
+
+void HeadlessContext::releaseCurrent() {
+	eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+}
+#else
+bool HeadlessContext::createContext() {
+	glfwInit();
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GlDebug::wantsDebugContext() ? GLFW_TRUE : GLFW_FALSE);
+	hiddenWindow = glfwCreateWindow(options.width, options.height, "headless", nullptr, nullptr);
+	if (hiddenWindow == nullptr) {
+		std::cerr << "GLFW hidden window creation failed" << std::endl;
+		glfwTerminate();
+		return false;
+	}
+	glfwMakeContextCurrent(hiddenWindow);
+	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+		std::cerr << "GLAD initialization failed" << std::endl;
+		destroyContext();
+		return false;
+	}
+	return true;
+}
+
+void HeadlessContext::destroyContext() {
+	if (hiddenWindow == nullptr) {
+		return;
+	}
+	glfwDestroyWindow(hiddenWindow);
+	hiddenWindow = nullptr;
+	glfwTerminate();
+}
+
+bool HeadlessContext::makeCurrent() {
+	glfwMakeContextCurrent(hiddenWindow);
+	return hiddenWindow != nullptr;
+}
+
+void HeadlessContext::releaseCurrent() {
+	glfwMakeContextCurrent(nullptr);
+}
+#endif
@@ -0,0 +1,93 @@
+#pragma once
+
+#ifndef FRAME_SCHEDULER_HPP
+#define FRAME_SCHEDULER_HPP
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <frame_stats.hpp>
+
+#include <chrono>
+#include <string>
+
+enum class SwapMode {
+	Off,      // swap interval 0
+	Vsync,    // swap interval 1
+	Adaptive  // swap interval -1: vsync, but late frames tear instead of waiting a whole refresh
+};
+
+// Command line options for frame pacing:
+// --vsync on|off|adaptive sets the swap interval, --fps-cap N limits the frame rate,
+// --jit-input polls input as late as the frame budget allows,
+// --frames-in-flight K keeps at most K frames queued on the GPU (0 leaves it to the driver)
+struct SchedulerOptions {
+	SwapMode swapMode;
+	double fpsCap;
+	bool justInTimeInput;
+	int framesInFlight;
+	// headless frames are never swapped, so the swap mode does not apply
+	bool offscreen;
+	// off when another thread owns the window's events; set by the demo, not the command line
+	bool pollEvents;
+
+	static SchedulerOptions parse(int argc, char** argv, bool headless);
+	// Short label for reports, e.g. "vsync, cap 120, jit input, 2 in flight"
+	std::string describe() const;
+};
+
+// Runs the start and end of every frame: waits on the fence of the frame
+// K frames back, holds the frame cap with a sleep followed by a short spin,
+// polls input (late, with --jit-input) and presents. Each frame gets a
+// GL_TIMESTAMP query after its last command; latency is the time from the
+// input poll to that timestamp on the CPU clock, so it covers simulation,
+// submission and GPU work but not scanout. Results go to FrameStats.
+class FrameScheduler {
+public:
+	FrameScheduler(const SchedulerOptions& options, FrameStats& frameStats);
+	~FrameScheduler() = default;
+
+	// Call once the context is current; window is null when headless
+	void create(GLFWwindow* window);
+	// Frame pacing waits, then glfwPollEvents (skipped when headless or pollEvents is off)
+	void beginFrame();
+	// Fence and timestamp for this frame, then glfwSwapBuffers
+	void present();
+	// Collects the remaining latency samples and deletes the GL objects
+	void destroy();
+
+private:
+	struct FrameSlot {
+		GLsync fence;
+		unsigned int timestampQuery;
+		std::chrono::steady_clock::time_point inputTime;
+	};
+
+	void waitUntil(std::chrono::steady_clock::time_point target);
+	void resolveSlot(FrameSlot& slot, bool wait);
+	void calibrateClock();
+
+	static const int SLOT_COUNT = 8;
+	static const int WORK_WINDOW = 30;
+
+	const SchedulerOptions& options;
+	FrameStats& frameStats;
+	GLFWwindow* window;
+	FrameSlot slots[SLOT_COUNT];
+	unsigned long frameIndex;
+	std::chrono::nanoseconds framePeriod;
+	std::chrono::steady_clock::time_point nextDeadline;
+	std::chrono::steady_clock::time_point lastPresent;
+	std::chrono::steady_clock::time_point inputTime;
+	// the last WORK_WINDOW poll-to-present times, for picking the just-in-time poll point;
+	// a fixed ring so presenting never allocates
+	double recentWorkMs[WORK_WINDOW];
+	unsigned long recentWorkCount;
+	// how far sleeps overshoot on this OS, so the spin covers it
+	double spinMarginMs;
+	// GPU timestamp minus CPU steady_clock, in nanoseconds
+	long long gpuClockOffset;
+	bool timestampsSupported;
+};
+
+#endif
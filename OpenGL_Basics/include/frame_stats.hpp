@@ -0,0 +1,43 @@
+#pragma once
+
+#ifndef FRAME_STATS_HPP
+#define FRAME_STATS_HPP
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Wall-clock time of every frame, plus input latency samples from the
+// frame scheduler, summarised into a JSON report together with startup
+// time (process start to first frame), draw calls per frame and peak
+// resident memory. Reports written to a file also carry the raw frame
+// times, which the benchmark runner's significance test needs.
+class FrameStats {
+public:
+	FrameStats();
+	~FrameStats() = default;
+
+	// Makes room for frameCount frames up front, so recording them doesn't allocate
+	void reserve(size_t frameCount);
+	void beginFrame();
+	void endFrame();
+	void addDrawCalls(int count);
+	void addLatency(double ms);
+	// Frame pacing label the report is tagged with
+	void setPacing(const std::string& description);
+
+	// Writes the report to path, or to stdout when path is empty
+	void writeReport(const std::string& demoName, int width, int height, const std::string& path) const;
+	size_t getFrameCount() const;
+
+private:
+	std::chrono::steady_clock::time_point frameStart;
+	std::vector<double> frameMs;
+	std::vector<double> latencyMs;
+	std::string pacing;
+	double startupMs;
+	unsigned long long drawCalls;
+};
+
+#endif
@@ -0,0 +1,63 @@
+#pragma once
+
+#ifndef HEADLESS_CONTEXT_HPP
+#define HEADLESS_CONTEXT_HPP
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <iostream>
+#include <string>
+
+// Command line options shared by every demo:
+// --headless renders offscreen without a window, --frames N sets how many frames,
+// --size WxH the render target size, --dump DIR writes frames as PPM images
+// (every --dump-every N frames), --report FILE writes the frame time report as JSON
+struct HeadlessOptions {
+	bool enabled;
+	int frames;
+	int width;
+	int height;
+	std::string dumpDirectory;
+	int dumpEvery;
+	std::string reportPath;
+
+	static HeadlessOptions parse(int argc, char** argv, int defaultWidth, int defaultHeight);
+};
+
+// OpenGL 4.6 core context with no window, rendering into a framebuffer
+// object. On Linux this is an EGL surfaceless context, which Mesa's
+// llvmpipe provides on machines without a GPU; elsewhere it falls back to
+// an invisible GLFW window. Loads glad on success.
+class HeadlessContext {
+public:
+	HeadlessContext(const HeadlessOptions& options);
+	~HeadlessContext() = default;
+
+	bool create();
+	// Binds the offscreen target; draws go there until endFrame
+	void beginFrame();
+	// Dumps the frame if requested
+	void endFrame(int frame);
+	bool dumpFrame(const std::string& path) const;
+	void destroy();
+	// Binds or unbinds the context on the calling thread, to hand it to a render thread
+	bool makeCurrent();
+	void releaseCurrent();
+
+	// Animation time for a frame, fixed at 60 Hz so runs are repeatable
+	static float getFrameTime(int frame);
+
+private:
+	bool createContext();
+	void destroyContext();
+
+	const HeadlessOptions& options;
+	void* display;
+	void* context;
+	GLFWwindow* hiddenWindow;
+	unsigned int framebuffer;
+	unsigned int colorBuffer;
+	unsigned int depthBuffer;
+};
+
+#endif
@@ -3,16 +3,23 @@
 #include <GLFW/glfw3.h>
 
 // std
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
+#include <string>
 #include <vector>
 
 // local
 #include <shader_manager.hpp>
+#include <board_generator.hpp>
+#include <headless_context.hpp>
+#include <frame_stats.hpp>
+#include <frame_scheduler.hpp>
+#include <gl_debug.hpp>
 
 const int WIDTH = 800;
 const int HEIGHT = 800;
 const int BOARD_SIZE = 8;
-const float SQUARE_SIZE = 2.0f / BOARD_SIZE;
 const float BOARD_START_X = -1.0f;
 const float BOARD_START_Y = -1.0f;
 
@@ -22,77 +29,62 @@ void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
 }
 
 // main
-int main() {
+int main(int argc, char** argv) {
 
     std::cout << "OpenGL Basics - Initializing..." << std::endl;
 
-    glfwInit();
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-
-    GLFWwindow* window = glfwCreateWindow(WIDTH, HEIGHT, "OpenGL Basics", nullptr, nullptr);
-    if (window == nullptr) {
-        std::cerr << "GLFW window creation failed" << std::endl;
-        glfwTerminate();
-        return -1;
+    // --board-size N draws an N x N board instead of 8 x 8
+    int boardSize = BOARD_SIZE;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--board-size" && i + 1 < argc) {
+            boardSize = std::max(1, std::atoi(argv[++i]));
+        }
     }
-    glfwMakeContextCurrent(window);
+    const float squareSize = 2.0f / boardSize;
+
+    HeadlessOptions headlessOptions = HeadlessOptions::parse(argc, argv, WIDTH, HEIGHT);
+    SchedulerOptions schedulerOptions = SchedulerOptions::parse(argc, argv, headlessOptions.enabled);
+    GlDebugOptions glDebugOptions = GlDebugOptions::parse(argc, argv);
+    HeadlessContext headlessContext(headlessOptions);
+    GLFWwindow* window = nullptr;
+    if (headlessOptions.enabled) {
+        if (!headlessContext.create()) {
+            return -1;
+        }
+    } else {
+        glfwInit();
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GlDebug::wantsDebugContext() ? GLFW_TRUE : GLFW_FALSE);
+
+        window = glfwCreateWindow(WIDTH, HEIGHT, "OpenGL Basics", nullptr, nullptr);
+        if (window == nullptr) {
+            std::cerr << "GLFW window creation failed" << std::endl;
+            glfwTerminate();
+            return -1;
+        }
+        glfwMakeContextCurrent(window);
 
-    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
-        std::cerr << "GLAD initialization failed" << std::endl;
-        glfwDestroyWindow(window);
-        glfwTerminate();
-        return -1;
+        if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+            std::cerr << "GLAD initialization failed" << std::endl;
+            glfwDestroyWindow(window);
+            glfwTerminate();
+            return -1;
+        }
+        glViewport(0, 0, WIDTH, HEIGHT);
+        glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
     }
+    GlDebug::install(glDebugOptions);
 
     ShaderManager shaderManager("shaders/vertex.glsl", "shaders/fragment.glsl");
-    glViewport(0, 0, WIDTH, HEIGHT);
-    glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
 
     // vertex and index gen
     std::vector<float> vertices;
     std::vector<unsigned int> indices;
 
-    unsigned int current_vertex_offset = 0;
-
-    for (int row = 0; row < BOARD_SIZE; ++row) {
-        for (int col = 0; col < BOARD_SIZE; ++col) {
-            float x_square_bl = BOARD_START_X + col * SQUARE_SIZE;
-            float y_square_bl = BOARD_START_Y + row * SQUARE_SIZE;
-            float r, g, b;
-            if ((row + col) % 2 == 0) {
-                // w
-                r = 1.0f; g = 1.0f; b = 1.0f;
-            } else {
-                // b
-                r = 0.1f; g = 0.1f; b = 0.1f;
-            }
-            vertices.push_back(x_square_bl);
-            vertices.push_back(y_square_bl);
-            vertices.push_back(0.0f);
-            vertices.push_back(r); vertices.push_back(g); vertices.push_back(b);
-            vertices.push_back(x_square_bl + SQUARE_SIZE);
-            vertices.push_back(y_square_bl);
-            vertices.push_back(0.0f);
-            vertices.push_back(r); vertices.push_back(g); vertices.push_back(b);
-            vertices.push_back(x_square_bl + SQUARE_SIZE);
-            vertices.push_back(y_square_bl + SQUARE_SIZE);
-            vertices.push_back(0.0f);
-            vertices.push_back(r); vertices.push_back(g); vertices.push_back(b);
-            vertices.push_back(x_square_bl);
-            vertices.push_back(y_square_bl + SQUARE_SIZE);
-            vertices.push_back(0.0f);
-            vertices.push_back(r); vertices.push_back(g); vertices.push_back(b);
-            indices.push_back(current_vertex_offset + 0);
-            indices.push_back(current_vertex_offset + 1);
-            indices.push_back(current_vertex_offset + 2);
-            indices.push_back(current_vertex_offset + 0);
-            indices.push_back(current_vertex_offset + 2);
-            indices.push_back(current_vertex_offset + 3);
-            current_vertex_offset += 4;
-        }
-    }
+    BoardGenerator::appendBoard(vertices, indices, boardSize, BOARD_START_X, BOARD_START_Y, squareSize);
 
     unsigned int VBO, VAO, EBO;
     glGenVertexArrays(1, &VAO);
@@ -103,6 +95,9 @@ int main() {
     glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+    GlDebug::label(GL_VERTEX_ARRAY, VAO, "board");
+    GlDebug::label(GL_BUFFER, VBO, "board vertices");
+    GlDebug::label(GL_BUFFER, EBO, "board indices");
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
@@ -118,25 +113,56 @@ int main() {
     std::cout << "Renderer: " << glGetString(GL_RENDERER) << std::endl;
     std::cout << "OpenGL Basics initialized successfully!" << std::endl;
 
-    while (!glfwWindowShouldClose(window)) {
-        if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS) {
+    FrameStats frameStats;
+    FrameScheduler frameScheduler(schedulerOptions, frameStats);
+    frameScheduler.create(window);
+    frameStats.setPacing(schedulerOptions.describe());
+    int frame = 0;
+    while (headlessOptions.enabled ? frame < headlessOptions.frames : !glfwWindowShouldClose(window)) {
+        frameStats.beginFrame();
+        frameScheduler.beginFrame();
+        if (headlessOptions.enabled) {
+            headlessContext.beginFrame();
+        } else if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS) {
             glfwSetWindowShouldClose(window, true);
         }
-        glClearColor(0.5f, 0.5f, 0.8f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT);
-        shaderManager.use();
-        glBindVertexArray(VAO);
-        glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, 0);
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+        {
+            GlDebugZone zone("board");
+            glClearColor(0.5f, 0.5f, 0.8f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+            shaderManager.use();
+            glBindVertexArray(VAO);
+            glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, 0);
+            frameStats.addDrawCalls(1);
+        }
+        {
+            GlDebugZone zone("present");
+            if (headlessOptions.enabled) {
+                headlessContext.endFrame(frame);
+            }
+            frameScheduler.present();
+        }
+        frameStats.endFrame();
+        GlDebug::endFrame();
+        ++frame;
+    }
+
+    frameScheduler.destroy();
+    GlDebug::report();
+    if (headlessOptions.enabled || !headlessOptions.reportPath.empty()) {
+        frameStats.writeReport("OpenGL Basics", headlessOptions.width, headlessOptions.height, headlessOptions.reportPath);
     }
 
     // clean
     glDeleteVertexArrays(1, &VAO);
     glDeleteBuffers(1, &VBO);
     glDeleteBuffers(1, &EBO);
-    glfwDestroyWindow(window);
-    glfwTerminate();
+    if (headlessOptions.enabled) {
+        headlessContext.destroy();
+    } else {
+        glfwDestroyWindow(window);
+        glfwTerminate();
+    }
 
     return 0;
 }
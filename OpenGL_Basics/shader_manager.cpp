@@ -1,4 +1,5 @@
 #include <shader_manager.hpp>
+#include <gl_debug.hpp>
 
 ShaderManager::ShaderManager(std::string vertexShaderPath, std::string fragmentShaderPath)
 	: vertexShaderPath(vertexShaderPath), fragmentShaderPath(fragmentShaderPath) {
@@ -60,6 +61,8 @@ void ShaderManager::loadShaders() {
 		glDeleteShader(vertexShader);
 		return;
 	}
+	// the fragment shader is what tells the programs here apart
+	GlDebug::label(GL_PROGRAM, shaderProgram, fragmentShaderPath.c_str());
 	// Clean up shaders after linking
 	glDeleteShader(vertexShader);
 	glDeleteShader(fragmentShader);
@@ -0,0 +1,177 @@
+#include <benchmark_runner.hpp>
+#include <statistics.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+RunnerOptions RunnerOptions::parse(int argc, char** argv) {
+	RunnerOptions options;
+	options.repoDirectory = "..";
+	options.frames = 300;
+	options.warmupFrames = 30;
+	options.repeats = 3;
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		if (arg == "--repo" && i + 1 < argc) {
+			options.repoDirectory = argv[++i];
+		} else if (arg == "--bin-dir" && i + 1 < argc) {
+			options.binaryDirectory = argv[++i];
+		} else if (arg == "--frames" && i + 1 < argc) {
+			options.frames = std::max(1, std::atoi(argv[++i]));
+		} else if (arg == "--warmup" && i + 1 < argc) {
+			options.warmupFrames = std::max(0, std::atoi(argv[++i]));
+		} else if (arg == "--repeats" && i + 1 < argc) {
+			options.repeats = std::max(1, std::atoi(argv[++i]));
+		} else if (arg == "--only" && i + 1 < argc) {
+			options.filter = argv[++i];
+		}
+	}
+	if (options.binaryDirectory.empty()) {
+		options.binaryDirectory = options.repoDirectory + "/bin";
+	}
+	options.warmupFrames = std::min(options.warmupFrames, options.frames - 1);
+	return options;
+}
+
+BenchmarkRunner::BenchmarkRunner(const RunnerOptions& options) : options(options) {}
+
+static std::string quote(const std::string& text) {
+	return "\"" + text + "\"";
+}
+
+std::string BenchmarkRunner::getExecutablePath(const std::string& project) const {
+#if defined(_WIN32)
+	return std::filesystem::absolute(options.binaryDirectory + "/" + project + ".exe").string();
+#else
+	return std::filesystem::absolute(options.binaryDirectory + "/" + project).string();
+#endif
+}
+
+bool BenchmarkRunner::runOnce(const BenchmarkCase& benchmarkCase, const std::string& reportPath, const std::string& logPath,
+	JsonValue& report, double& processMs) const {
+	std::remove(reportPath.c_str());
+	std::string projectDirectory = std::filesystem::absolute(options.repoDirectory + "/" + benchmarkCase.project).string();
+	std::ostringstream command;
+#if defined(_WIN32)
+	// cmd strips the outer quotes of /c, so wrap the whole line once more
+	command << "\"cd /d " << quote(projectDirectory) << " && ";
+#else
+	command << "cd " << quote(projectDirectory) << " && ";
+#endif
+	command << quote(getExecutablePath(benchmarkCase.project)) << " --headless --frames " << options.frames
+		<< " --report " << quote(reportPath);
+	for (const std::string& argument : benchmarkCase.arguments) {
+		command << " " << argument;
+	}
+	command << " >> " << quote(logPath) << " 2>&1";
+#if defined(_WIN32)
+	command << "\"";
+#endif
+
+	auto start = std::chrono::steady_clock::now();
+	int status = std::system(command.str().c_str());
+	processMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	if (status != 0) {
+		std::cerr << benchmarkCase.name << ": exited with status " << status << ", see " << logPath << std::endl;
+		return false;
+	}
+	std::string error;
+	if (!JsonValue::parseFile(reportPath, report, error)) {
+		std::cerr << benchmarkCase.name << ": no usable report (" << error << ")" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+bool BenchmarkRunner::run(const std::vector<BenchmarkCase>& cases, const std::string& outputPath) {
+	std::string reportPath = std::filesystem::absolute(outputPath + ".run.json").string();
+	std::string logPath = std::filesystem::absolute(outputPath + ".log").string();
+	std::ofstream(logPath, std::ios::trunc);
+
+	std::ostringstream json;
+	json << "{\n"
+		<< "  \"frames\": " << options.frames << ",\n"
+		<< "  \"warmup_frames\": " << options.warmupFrames << ",\n"
+		<< "  \"repeats\": " << options.repeats << ",\n"
+		<< "  \"cases\": [";
+
+	bool allSucceeded = true;
+	bool firstCase = true;
+	std::printf("%-36s %10s %10s %10s %10s %8s %10s\n", "case", "startup", "mean ms", "p95 ms", "p99 ms", "draws", "peak MB");
+	for (const BenchmarkCase& benchmarkCase : cases) {
+		if (!options.filter.empty() && benchmarkCase.name.find(options.filter) == std::string::npos) {
+			continue;
+		}
+
+		std::vector<double> startupMs, processMs, frameMs;
+		double drawCalls = 0.0, peakKb = 0.0;
+		std::string renderer;
+		int succeeded = 0;
+		for (int repeat = 0; repeat < options.repeats; ++repeat) {
+			JsonValue report;
+			double wallMs = 0.0;
+			if (!runOnce(benchmarkCase, reportPath, logPath, report, wallMs)) {
+				continue;
+			}
+			++succeeded;
+			processMs.push_back(wallMs);
+			startupMs.push_back(report["startup_ms"].getNumber());
+			drawCalls = report["draw_calls_per_frame"].getNumber();
+			peakKb = std::max(peakKb, report["peak_rss_kb"].getNumber());
+			renderer = report["renderer"].getString();
+			std::vector<double> samples = report["frame_samples_ms"].getNumbers();
+			// the first frames pay for shader compiles and first-touch allocations
+			if ((int)samples.size() > options.warmupFrames) {
+				frameMs.insert(frameMs.end(), samples.begin() + options.warmupFrames, samples.end());
+			}
+		}
+		std::remove(reportPath.c_str());
+		allSucceeded = allSucceeded && succeeded == options.repeats;
+
+		Statistics::Summary frames = Statistics::summarize(frameMs);
+		Statistics::Summary startup = Statistics::summarize(startupMs);
+		std::printf("%-36s %10.1f %10.3f %10.3f %10.3f %8.1f %10.1f%s\n", benchmarkCase.name.c_str(), startup.mean,
+			frames.mean, frames.p95, frames.p99, drawCalls, peakKb / 1024.0, succeeded < options.repeats ? "  (failed runs)" : "");
+
+		std::string arguments;
+		for (const std::string& argument : benchmarkCase.arguments) {
+			arguments += (arguments.empty() ? "" : " ") + argument;
+		}
+		json << (firstCase ? "\n" : ",\n") << "    {\n"
+			<< "      \"name\": \"" << benchmarkCase.name << "\",\n"
+			<< "      \"project\": \"" << benchmarkCase.project << "\",\n"
+			<< "      \"arguments\": \"" << arguments << "\",\n"
+			<< "      \"renderer\": \"" << renderer << "\",\n"
+			<< "      \"runs\": " << succeeded << ",\n"
+			<< "      \"startup_ms\": " << Statistics::toJson(startup) << ",\n"
+			<< "      \"process_ms\": " << Statistics::toJson(Statistics::summarize(processMs)) << ",\n"
+			<< "      \"frame_ms\": " << Statistics::toJson(frames) << ",\n"
+			<< "      \"draw_calls_per_frame\": " << drawCalls << ",\n"
+			<< "      \"peak_rss_kb\": " << peakKb << ",\n"
+			<< "      \"startup_samples_ms\": [";
+		for (size_t i = 0; i < startupMs.size(); ++i) {
+			json << (i > 0 ? ", " : "") << startupMs[i];
+		}
+		json << "],\n      \"frame_samples_ms\": [";
+		for (size_t i = 0; i < frameMs.size(); ++i) {
+			json << (i > 0 ? ", " : "") << frameMs[i];
+		}
+		json << "]\n    }";
+		firstCase = false;
+	}
+	json << "\n  ]\n}\n";
+
+	std::ofstream file(outputPath);
+	if (!file) {
+		std::cerr << "Failed to write results: " << outputPath << std::endl;
+		return false;
+	}
+	file << json.str();
+	std::cout << "Results written to " << outputPath << std::endl;
+	return allSucceeded;
+}
@@ -0,0 +1,26 @@
+#include <benchmark_suite.hpp>
+
+std::vector<BenchmarkCase> BenchmarkSuite::getDefaultCases() {
+	std::vector<BenchmarkCase> cases;
+	for (const char* boardSize : { "8", "64", "256" }) {
+		cases.push_back({ std::string("basics/board-size=") + boardSize, "OpenGL_Basics", { "--board-size", boardSize } });
+	}
+	cases.push_back({ "reloaded/default", "OpenGL_Reloaded", {} });
+	for (const char* segments : { "100", "10000", "100000" }) {
+		cases.push_back({ std::string("shapes/segments=") + segments, "OpenGL_Shapes", { "--segments", segments } });
+	}
+	cases.push_back({ "shapes/sdf", "OpenGL_Shapes", { "--sdf" } });
+	cases.push_back({ "scenery/default", "OpenGL_Scenery", {} });
+	cases.push_back({ "scenery/indirect", "OpenGL_Scenery", { "--indirect" } });
+	cases.push_back({ "scenery/clutter=2000", "OpenGL_Scenery", { "--clutter", "2000" } });
+	cases.push_back({ "scenery/clutter=2000/unsorted", "OpenGL_Scenery", { "--clutter", "2000", "--unsorted" } });
+	cases.push_back({ "transformations/default", "OpenGL_Transformations", {} });
+	for (const char* instances : { "10000", "100000" }) {
+		cases.push_back({ std::string("transformations/instances=") + instances, "OpenGL_Transformations",
+			{ "--instanced", "--instances", instances } });
+	}
+	for (const char* size : { "640x360", "1280x720", "1920x1080" }) {
+		cases.push_back({ std::string("wave/size=") + size, "OpenGL_Wave", { "--size", size } });
+	}
+	return cases;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#ifndef BENCHMARK_RUNNER_HPP
+#define BENCHMARK_RUNNER_HPP
+
+#include <benchmark_suite.hpp>
+#include <json_value.hpp>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+// --repo DIR is the checkout holding the OpenGL_* folders, --bin-dir DIR the
+// built demos named after their folders, --frames N and --warmup N the frames
+// per run and how many of them to drop, --repeats N the runs per case,
+// --only TEXT keeps the cases whose name contains TEXT
+struct RunnerOptions {
+	std::string repoDirectory;
+	std::string binaryDirectory;
+	int frames;
+	int warmupFrames;
+	int repeats;
+	std::string filter;
+
+	static RunnerOptions parse(int argc, char** argv);
+};
+
+// Launches each demo as a child process with --headless --report from its
+// project folder (the demos load shaders by relative path), collects the
+// frame reports and merges every case's repeats into one result file:
+// startup time per run, pooled frame times after warm-up, draw calls per
+// frame and peak resident memory.
+class BenchmarkRunner {
+public:
+	BenchmarkRunner(const RunnerOptions& options);
+	~BenchmarkRunner() = default;
+
+	// Returns false if any run failed; the result file is written regardless
+	bool run(const std::vector<BenchmarkCase>& cases, const std::string& outputPath);
+
+private:
+	bool runOnce(const BenchmarkCase& benchmarkCase, const std::string& reportPath, const std::string& logPath,
+		JsonValue& report, double& processMs) const;
+	std::string getExecutablePath(const std::string& project) const;
+
+	const RunnerOptions& options;
+};
+
+#endif
@@ -0,0 +1,24 @@
+#pragma once
+
+#ifndef BENCHMARK_SUITE_HPP
+#define BENCHMARK_SUITE_HPP
+
+#include <string>
+#include <vector>
+
+// One demo run configuration. Every case runs headless for a fixed number
+// of frames on the fixed 60 Hz clock, so the same case always renders the
+// same frames.
+struct BenchmarkCase {
+	std::string name;    // unique key results are matched on, e.g. "basics/board-size=64"
+	std::string project; // project folder and executable name, e.g. "OpenGL_Basics"
+	std::vector<std::string> arguments;
+};
+
+namespace BenchmarkSuite {
+	// Parameter sweeps over all six demos: board size, circle segments,
+	// Scenery's submit path and draw order, instance count and resolution
+	std::vector<BenchmarkCase> getDefaultCases();
+}
+
+#endif
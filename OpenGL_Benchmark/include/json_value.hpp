@@ -0,0 +1,44 @@
+#pragma once
+
+#ifndef JSON_VALUE_HPP
+#define JSON_VALUE_HPP
+
+#include <map>
+#include <string>
+#include <vector>
+
+// Just enough JSON to read the demos' frame reports and the runner's own
+// result files back: objects, arrays, numbers, strings, booleans and null.
+class JsonValue {
+public:
+	enum class Type { Null, Bool, Number, String, Array, Object };
+
+	JsonValue();
+
+	// Returns false and fills error on malformed input
+	static bool parse(const std::string& text, JsonValue& value, std::string& error);
+	static bool parseFile(const std::string& path, JsonValue& value, std::string& error);
+
+	Type getType() const;
+	bool isNull() const;
+	double getNumber(double fallback = 0.0) const;
+	const std::string& getString() const;
+	const std::vector<JsonValue>& getArray() const;
+	// Member lookup; missing members and non-objects give a null value
+	const JsonValue& operator[](const std::string& key) const;
+	bool has(const std::string& key) const;
+	// Array of numbers as doubles, skipping anything else
+	std::vector<double> getNumbers() const;
+
+private:
+	Type type;
+	bool boolean;
+	double number;
+	std::string text;
+	std::vector<JsonValue> items;
+	std::map<std::string, JsonValue> members;
+
+	friend class JsonParser;
+};
+
+#endif
@@ -0,0 +1,20 @@
+#pragma once
+
+#ifndef RESULT_COMPARE_HPP
+#define RESULT_COMPARE_HPP
+
+#include <string>
+
+// Compares two result files case by case. A case regresses when its frame or
+// startup time is both slower by more than thresholdPercent and significant
+// under Welch's t-test at alpha; the threshold keeps thousands of pooled frame
+// samples from flagging differences too small to matter. Peak memory has one
+// sample per case, so it only needs to grow by more than thresholdPercent and
+// at least 1 MB.
+namespace ResultCompare {
+	// Prints a table and returns the number of regressions, or -1 if either file can't be read
+	int compare(const std::string& baselinePath, const std::string& candidatePath, double thresholdPercent = 5.0,
+		double alpha = 0.01);
+}
+
+#endif
@@ -0,0 +1,38 @@
+#pragma once
+
+#ifndef STATISTICS_HPP
+#define STATISTICS_HPP
+
+#include <string>
+#include <vector>
+
+namespace Statistics {
+	struct Summary {
+		size_t count;
+		double mean;
+		double stddev;
+		double min;
+		double median;
+		double p95;
+		double p99;
+		double max;
+	};
+
+	struct WelchResult {
+		double t;
+		double degreesOfFreedom;
+		// one-sided: probability of a difference at least this large in the
+		// candidate's direction if both samples shared a mean
+		double pValue;
+	};
+
+	// Mean, sample standard deviation and nearest-rank percentiles, as the demos report them
+	Summary summarize(const std::vector<double>& samples);
+	std::string toJson(const Summary& summary);
+	// Welch's unequal-variance t-test of candidate's mean against baseline's
+	WelchResult welchTest(const std::vector<double>& baseline, const std::vector<double>& candidate);
+	// P(T > t) for Student's t with the given degrees of freedom
+	double studentTailProbability(double t, double degreesOfFreedom);
+}
+
+#endif
@@ -0,0 +1,243 @@
+#include <json_value.hpp>
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+class JsonParser {
+public:
+	JsonParser(const std::string& text) : text(text), position(0) {}
+
+	bool parseDocument(JsonValue& value, std::string& error) {
+		if (!parseValue(value)) {
+			error = message;
+			return false;
+		}
+		skipWhitespace();
+		if (position != text.size()) {
+			error = "trailing characters at offset " + std::to_string(position);
+			return false;
+		}
+		return true;
+	}
+
+private:
+	bool fail(const std::string& what) {
+		message = what + " at offset " + std::to_string(position);
+		return false;
+	}
+
+	void skipWhitespace() {
+		while (position < text.size() && (text[position] == ' ' || text[position] == '\n' || text[position] == '\r' || text[position] == '\t')) {
+			++position;
+		}
+	}
+
+	bool consume(const char* literal) {
+		size_t length = std::char_traits<char>::length(literal);
+		if (text.compare(position, length, literal) != 0) {
+			return false;
+		}
+		position += length;
+		return true;
+	}
+
+	bool parseValue(JsonValue& value) {
+		skipWhitespace();
+		if (position >= text.size()) {
+			return fail("unexpected end");
+		}
+		char c = text[position];
+		if (c == '{') {
+			return parseObject(value);
+		}
+		if (c == '[') {
+			return parseArray(value);
+		}
+		if (c == '"') {
+			value.type = JsonValue::Type::String;
+			return parseString(value.text);
+		}
+		if (consume("true")) {
+			value.type = JsonValue::Type::Bool;
+			value.boolean = true;
+			return true;
+		}
+		if (consume("false")) {
+			value.type = JsonValue::Type::Bool;
+			value.boolean = false;
+			return true;
+		}
+		if (consume("null")) {
+			value.type = JsonValue::Type::Null;
+			return true;
+		}
+		// strtod also accepts inf and nan, which the reports can contain on empty runs
+		const char* start = text.c_str() + position;
+		char* end = nullptr;
+		double number = std::strtod(start, &end);
+		if (end == start) {
+			return fail("unexpected character");
+		}
+		position += end - start;
+		value.type = JsonValue::Type::Number;
+		value.number = number;
+		return true;
+	}
+
+	bool parseString(std::string& out) {
+		++position;
+		while (position < text.size() && text[position] != '"') {
+			char c = text[position++];
+			if (c == '\\' && position < text.size()) {
+				char escaped = text[position++];
+				switch (escaped) {
+				case 'n': out += '\n'; break;
+				case 't': out += '\t'; break;
+				case 'r': out += '\r'; break;
+				case 'b': out += '\b'; break;
+				case 'f': out += '\f'; break;
+				case 'u':
+					// names and labels are ASCII; keep anything else as a placeholder
+					position += 4;
+					out += '?';
+					break;
+				default: out += escaped; break;
+				}
+			} else {
+				out += c;
+			}
+		}
+		if (position >= text.size()) {
+			return fail("unterminated string");
+		}
+		++position;
+		return true;
+	}
+
+	bool parseArray(JsonValue& value) {
+		value.type = JsonValue::Type::Array;
+		++position;
+		skipWhitespace();
+		if (position < text.size() && text[position] == ']') {
+			++position;
+			return true;
+		}
+		for (;;) {
+			value.items.emplace_back();
+			if (!parseValue(value.items.back())) {
+				return false;
+			}
+			skipWhitespace();
+			if (position < text.size() && text[position] == ',') {
+				++position;
+			} else if (position < text.size() && text[position] == ']') {
+				++position;
+				return true;
+			} else {
+				return fail("expected , or ]");
+			}
+		}
+	}
+
+	bool parseObject(JsonValue& value) {
+		value.type = JsonValue::Type::Object;
+		++position;
+		skipWhitespace();
+		if (position < text.size() && text[position] == '}') {
+			++position;
+			return true;
+		}
+		for (;;) {
+			skipWhitespace();
+			std::string key;
+			if (position >= text.size() || text[position] != '"' || !parseString(key)) {
+				return fail("expected member name");
+			}
+			skipWhitespace();
+			if (position >= text.size() || text[position] != ':') {
+				return fail("expected :");
+			}
+			++position;
+			if (!parseValue(value.members[key])) {
+				return false;
+			}
+			skipWhitespace();
+			if (position < text.size() && text[position] == ',') {
+				++position;
+			} else if (position < text.size() && text[position] == '}') {
+				++position;
+				return true;
+			} else {
+				return fail("expected , or }");
+			}
+		}
+	}
+
+	const std::string& text;
+	size_t position;
+	std::string message;
+};
+
+JsonValue::JsonValue() : type(Type::Null), boolean(false), number(0.0) {}
+
+bool JsonValue::parse(const std::string& text, JsonValue& value, std::string& error) {
+	value = JsonValue();
+	JsonParser parser(text);
+	return parser.parseDocument(value, error);
+}
+
+bool JsonValue::parseFile(const std::string& path, JsonValue& value, std::string& error) {
+	std::ifstream file(path);
+	if (!file) {
+		error = "cannot open " + path;
+		return false;
+	}
+	std::ostringstream contents;
+	contents << file.rdbuf();
+	if (!parse(contents.str(), value, error)) {
+		error = path + ": " + error;
+		return false;
+	}
+	return true;
+}
+
+JsonValue::Type JsonValue::getType() const {
+	return type;
+}
+
+bool JsonValue::isNull() const {
+	return type == Type::Null;
+}
+
+double JsonValue::getNumber(double fallback) const {
+	return type == Type::Number ? number : fallback;
+}
+
+const std::string& JsonValue::getString() const {
+	return text;
+}
+
+const std::vector<JsonValue>& JsonValue::getArray() const {
+	return items;
+}
+
+const JsonValue& JsonValue::operator[](const std::string& key) const {
+	static const JsonValue null;
+	auto found = members.find(key);
+	return found != members.end() ? found->second : null;
+}
+
+bool JsonValue::has(const std::string& key) const {
+	return members.count(key) > 0;
+}
+
+std::vector<double> JsonValue::getNumbers() const {
+	std::vector<double> numbers;
+	for (const JsonValue& item : items) {
+		if (item.type == Type::Number) {
+			numbers.push_back(item.number);
+		}
+	}
+	return numbers;
+}
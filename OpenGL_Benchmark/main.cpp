@@ -0,0 +1,63 @@
+// std
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// local
+#include <benchmark_runner.hpp>
+#include <benchmark_suite.hpp>
+#include <result_compare.hpp>
+
+int main(int argc, char** argv) {
+    // Runs from this folder by default; the demos must already be built into --bin-dir.
+    // --repo DIR, --bin-dir DIR, --frames N, --warmup N, --repeats N and --only TEXT configure the runs (see RunnerOptions),
+    // --output FILE sets the result file (default benchmark_results.json),
+    // --list prints the cases and exits,
+    // --compare BASELINE CANDIDATE compares two result files instead of running,
+    // --threshold PERCENT and --alpha P set what counts as a regression (default 5 and 0.01);
+    // the exit code is 1 on any regression or failed run
+    std::string outputPath = "benchmark_results.json";
+    std::string baselinePath, candidatePath;
+    double thresholdPercent = 5.0;
+    double alpha = 0.01;
+    bool list = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--output" && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else if (arg == "--compare" && i + 2 < argc) {
+            baselinePath = argv[++i];
+            candidatePath = argv[++i];
+        } else if (arg == "--threshold" && i + 1 < argc) {
+            thresholdPercent = std::atof(argv[++i]);
+        } else if (arg == "--alpha" && i + 1 < argc) {
+            alpha = std::atof(argv[++i]);
+        } else if (arg == "--list") {
+            list = true;
+        }
+    }
+
+    if (!baselinePath.empty()) {
+        int regressions = ResultCompare::compare(baselinePath, candidatePath, thresholdPercent, alpha);
+        return regressions == 0 ? 0 : 1;
+    }
+
+    std::vector<BenchmarkCase> cases = BenchmarkSuite::getDefaultCases();
+    if (list) {
+        for (const BenchmarkCase& benchmarkCase : cases) {
+            std::printf("%-36s %s", benchmarkCase.name.c_str(), benchmarkCase.project.c_str());
+            for (const std::string& argument : benchmarkCase.arguments) {
+                std::printf(" %s", argument.c_str());
+            }
+            std::printf("\n");
+        }
+        return 0;
+    }
+
+    RunnerOptions options = RunnerOptions::parse(argc, argv);
+    std::cout << "Running " << options.repeats << " x " << options.frames << " frames per case from "
+        << options.binaryDirectory << std::endl;
+    return BenchmarkRunner(options).run(cases, outputPath) ? 0 : 1;
+}
@@ -0,0 +1,87 @@
+#include <result_compare.hpp>
+#include <json_value.hpp>
+#include <statistics.hpp>
+
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+namespace ResultCompare {
+	static const JsonValue* findCase(const JsonValue& results, const std::string& name) {
+		for (const JsonValue& entry : results["cases"].getArray()) {
+			if (entry["name"].getString() == name) {
+				return &entry;
+			}
+		}
+		return nullptr;
+	}
+
+	// Prints one metric row and returns true if it regressed
+	static bool compareSamples(const std::string& label, const std::vector<double>& baseline,
+		const std::vector<double>& candidate, double thresholdPercent, double alpha) {
+		Statistics::Summary before = Statistics::summarize(baseline);
+		Statistics::Summary after = Statistics::summarize(candidate);
+		if (before.count < 2 || after.count < 2 || before.mean <= 0.0) {
+			std::printf("  %-12s %12.3f %12.3f %10s %10s  not enough samples\n", label.c_str(), before.mean, after.mean, "-", "-");
+			return false;
+		}
+		double change = (after.mean - before.mean) / before.mean * 100.0;
+		Statistics::WelchResult test = Statistics::welchTest(baseline, candidate);
+		bool regressed = change > thresholdPercent && test.t > 0.0 && test.pValue < alpha;
+		bool improved = change < -thresholdPercent && test.t < 0.0 && test.pValue < alpha;
+		std::printf("  %-12s %12.3f %12.3f %+9.1f%% %10.2g  %s\n", label.c_str(), before.mean, after.mean, change,
+			test.pValue, regressed ? "REGRESSION" : improved ? "improved" : "");
+		return regressed;
+	}
+
+	int compare(const std::string& baselinePath, const std::string& candidatePath, double thresholdPercent, double alpha) {
+		JsonValue baseline, candidate;
+		std::string error;
+		if (!JsonValue::parseFile(baselinePath, baseline, error)) {
+			std::cerr << "Failed to read " << baselinePath << ": " << error << std::endl;
+			return -1;
+		}
+		if (!JsonValue::parseFile(candidatePath, candidate, error)) {
+			std::cerr << "Failed to read " << candidatePath << ": " << error << std::endl;
+			return -1;
+		}
+
+		std::printf("threshold %.1f%%, alpha %.3g\n", thresholdPercent, alpha);
+		std::printf("  %-12s %12s %12s %10s %10s\n", "metric", "baseline", "candidate", "change", "p");
+		int regressions = 0;
+		for (const JsonValue& after : candidate["cases"].getArray()) {
+			const std::string& name = after["name"].getString();
+			std::printf("%s\n", name.c_str());
+			const JsonValue* before = findCase(baseline, name);
+			if (before == nullptr) {
+				std::printf("  new case, no baseline\n");
+				continue;
+			}
+			if (compareSamples("frame ms", (*before)["frame_samples_ms"].getNumbers(), after["frame_samples_ms"].getNumbers(),
+				thresholdPercent, alpha)) {
+				++regressions;
+			}
+			if (compareSamples("startup ms", (*before)["startup_samples_ms"].getNumbers(),
+				after["startup_samples_ms"].getNumbers(), thresholdPercent, alpha)) {
+				++regressions;
+			}
+
+			double beforeKb = (*before)["peak_rss_kb"].getNumber();
+			double afterKb = after["peak_rss_kb"].getNumber();
+			double growth = beforeKb > 0.0 ? (afterKb - beforeKb) / beforeKb * 100.0 : 0.0;
+			bool memoryRegressed = growth > thresholdPercent && afterKb - beforeKb > 1024.0;
+			std::printf("  %-12s %12.0f %12.0f %+9.1f%% %10s  %s\n", "peak kB", beforeKb, afterKb, growth, "-",
+				memoryRegressed ? "REGRESSION" : "");
+			if (memoryRegressed) {
+				++regressions;
+			}
+		}
+		for (const JsonValue& before : baseline["cases"].getArray()) {
+			if (findCase(candidate, before["name"].getString()) == nullptr) {
+				std::printf("%s\n  missing from candidate\n", before["name"].getString().c_str());
+			}
+		}
+		std::printf("%d regression%s\n", regressions, regressions == 1 ? "" : "s");
+		return regressions;
+	}
+}
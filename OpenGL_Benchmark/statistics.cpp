@@ -0,0 +1,121 @@
+#include <statistics.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+Statistics::Summary Statistics::summarize(const std::vector<double>& samples) {
+	Summary summary = { samples.size(), 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+	if (samples.empty()) {
+		return summary;
+	}
+	std::vector<double> sorted = samples;
+	std::sort(sorted.begin(), sorted.end());
+	double total = 0.0;
+	for (double value : sorted) {
+		total += value;
+	}
+	summary.mean = total / sorted.size();
+	double variance = 0.0;
+	for (double value : sorted) {
+		variance += (value - summary.mean) * (value - summary.mean);
+	}
+	summary.stddev = sorted.size() > 1 ? std::sqrt(variance / (sorted.size() - 1)) : 0.0;
+	auto percentile = [&](double p) {
+		size_t rank = (size_t)std::ceil(p / 100.0 * sorted.size());
+		return sorted[std::min(sorted.size() - 1, rank > 0 ? rank - 1 : 0)];
+	};
+	summary.min = sorted.front();
+	summary.median = percentile(50.0);
+	summary.p95 = percentile(95.0);
+	summary.p99 = percentile(99.0);
+	summary.max = sorted.back();
+	return summary;
+}
+
+std::string Statistics::toJson(const Summary& summary) {
+	std::ostringstream json;
+	json << "{ \"count\": " << summary.count << ", \"mean\": " << summary.mean << ", \"stddev\": " << summary.stddev
+		<< ", \"min\": " << summary.min << ", \"median\": " << summary.median << ", \"p95\": " << summary.p95
+		<< ", \"p99\": " << summary.p99 << ", \"max\": " << summary.max << " }";
+	return json.str();
+}
+
+// continued fraction for the regularized incomplete beta function (modified Lentz)
+static double betaContinuedFraction(double a, double b, double x) {
+	const double tiny = 1e-300;
+	double qab = a + b, qap = a + 1.0, qam = a - 1.0;
+	double c = 1.0;
+	double d = 1.0 - qab * x / qap;
+	d = std::fabs(d) < tiny ? tiny : d;
+	d = 1.0 / d;
+	double h = d;
+	for (int m = 1; m <= 300; ++m) {
+		int m2 = 2 * m;
+		double aa = m * (b - m) * x / ((qam + m2) * (a + m2));
+		d = 1.0 + aa * d;
+		d = std::fabs(d) < tiny ? tiny : d;
+		c = 1.0 + aa / c;
+		c = std::fabs(c) < tiny ? tiny : c;
+		d = 1.0 / d;
+		h *= d * c;
+		aa = -(a + m) * (qab + m) * x / ((a + m2) * (qap + m2));
+		d = 1.0 + aa * d;
+		d = std::fabs(d) < tiny ? tiny : d;
+		c = 1.0 + aa / c;
+		c = std::fabs(c) < tiny ? tiny : c;
+		d = 1.0 / d;
+		double delta = d * c;
+		h *= delta;
+		if (std::fabs(delta - 1.0) < 1e-12) {
+			break;
+		}
+	}
+	return h;
+}
+
+static double incompleteBeta(double a, double b, double x) {
+	if (x <= 0.0) {
+		return 0.0;
+	}
+	if (x >= 1.0) {
+		return 1.0;
+	}
+	double logFront = std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b) + a * std::log(x) + b * std::log(1.0 - x);
+	// the fraction converges fast on one side of the mean; use the symmetry on the other
+	if (x < (a + 1.0) / (a + b + 2.0)) {
+		return std::exp(logFront) * betaContinuedFraction(a, b, x) / a;
+	}
+	return 1.0 - std::exp(logFront) * betaContinuedFraction(b, a, 1.0 - x) / b;
+}
+
+double Statistics::studentTailProbability(double t, double degreesOfFreedom) {
+	if (!(degreesOfFreedom > 0.0)) {
+		return 0.5;
+	}
+	double twoSided = incompleteBeta(degreesOfFreedom / 2.0, 0.5, degreesOfFreedom / (degreesOfFreedom + t * t));
+	return t > 0.0 ? twoSided / 2.0 : 1.0 - twoSided / 2.0;
+}
+
+Statistics::WelchResult Statistics::welchTest(const std::vector<double>& baseline, const std::vector<double>& candidate) {
+	WelchResult result = { 0.0, 0.0, 1.0 };
+	if (baseline.size() < 2 || candidate.size() < 2) {
+		return result;
+	}
+	Summary a = summarize(baseline);
+	Summary b = summarize(candidate);
+	double varianceA = a.stddev * a.stddev / a.count;
+	double varianceB = b.stddev * b.stddev / b.count;
+	double standardError = std::sqrt(varianceA + varianceB);
+	if (standardError == 0.0) {
+		// identical constant samples: any difference at all is certain
+		result.pValue = a.mean == b.mean ? 1.0 : 0.0;
+		result.t = a.mean == b.mean ? 0.0 : (b.mean > a.mean ? HUGE_VAL : -HUGE_VAL);
+		return result;
+	}
+	result.t = (b.mean - a.mean) / standardError;
+	result.degreesOfFreedom = (varianceA + varianceB) * (varianceA + varianceB)
+		/ (varianceA * varianceA / (a.count - 1) + varianceB * varianceB / (b.count - 1));
+	result.pValue = studentTailProbability(std::fabs(result.t), result.degreesOfFreedom);
+	return result;
+}
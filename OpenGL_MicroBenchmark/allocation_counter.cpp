@@ -0,0 +1,94 @@
+#include <allocation_counter.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<size_t> allocationCount(0);
+static std::atomic<size_t> allocatedBytes(0);
+static std::atomic<size_t> liveBytes(0);
+static std::atomic<size_t> peakBytes(0);
+
+// every block carries its size in front so delete can take it off the live total;
+// 16 bytes keeps malloc's alignment
+static const size_t HEADER_SIZE = 16;
+
+static void* countedAllocate(size_t size) {
+	allocationCount.fetch_add(1, std::memory_order_relaxed);
+	allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+	unsigned char* block = (unsigned char*)std::malloc(HEADER_SIZE + size);
+	if (block == nullptr) {
+		return nullptr;
+	}
+	*(size_t*)block = size;
+	size_t live = liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+	size_t peak = peakBytes.load(std::memory_order_relaxed);
+	while (live > peak && !peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+	}
+	return block + HEADER_SIZE;
+}
+
+static void countedFree(void* pointer) {
+	if (pointer == nullptr) {
+		return;
+	}
+	unsigned char* block = (unsigned char*)pointer - HEADER_SIZE;
+	liveBytes.fetch_sub(*(size_t*)block, std::memory_order_relaxed);
+	std::free(block);
+}
+
+void* operator new(size_t size) {
+	void* pointer = countedAllocate(size);
+	if (pointer == nullptr) {
+		throw std::bad_alloc();
+	}
+	return pointer;
+}
+
+void* operator new[](size_t size) {
+	return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+	return countedAllocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+	return countedAllocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+	countedFree(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+	countedFree(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+	countedFree(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+	countedFree(pointer);
+}
+
+size_t AllocationCounter::getAllocationCount() {
+	return allocationCount.load(std::memory_order_relaxed);
+}
+
+size_t AllocationCounter::getAllocatedBytes() {
+	return allocatedBytes.load(std::memory_order_relaxed);
+}
+
+size_t AllocationCounter::getLiveBytes() {
+	return liveBytes.load(std::memory_order_relaxed);
+}
+
+size_t AllocationCounter::getPeakBytes() {
+	return peakBytes.load(std::memory_order_relaxed);
+}
+
+void AllocationCounter::resetPeak() {
+	peakBytes.store(liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
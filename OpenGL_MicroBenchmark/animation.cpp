@@ -0,0 +1,191 @@
+#include <animation.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+AnimationSet::AnimationSet() : outputSize(0) {
+}
+
+size_t AnimationSet::addTrack(TrackTarget target, Interpolation interpolation, int components, bool loop,
+	const std::vector<float>& keyTimes, const std::vector<float>& keyValues, const std::vector<float>& keyControls) {
+	// the sampler indexes the shared arrays from these sizes without further checks
+	size_t keyCount = keyTimes.size();
+	if (components <= 0 || keyCount == 0 || keyValues.size() != keyCount * components) {
+		return INVALID_TRACK;
+	}
+	if (interpolation == Interpolation::Bezier && keyControls.size() != 2 * keyCount * components) {
+		return INVALID_TRACK;
+	}
+	for (size_t i = 1; i < keyCount; ++i) {
+		if (!(keyTimes[i] > keyTimes[i - 1])) {
+			return INVALID_TRACK;
+		}
+	}
+
+	AnimationTrack track;
+	track.target = target;
+	track.interpolation = interpolation;
+	track.components = components;
+	track.loop = loop;
+	track.firstKey = (uint32_t)times.size();
+	track.keyCount = (uint32_t)keyTimes.size();
+	track.valueOffset = (uint32_t)values.size();
+	track.controlOffset = (uint32_t)controls.size();
+	track.outputOffset = outputSize;
+	times.insert(times.end(), keyTimes.begin(), keyTimes.end());
+	values.insert(values.end(), keyValues.begin(), keyValues.end());
+	if (interpolation == Interpolation::Bezier) {
+		controls.insert(controls.end(), keyControls.begin(), keyControls.end());
+	}
+	outputSize += components;
+	tracks.push_back(track);
+	return tracks.size() - 1;
+}
+
+size_t AnimationSet::getTrackCount() const {
+	return tracks.size();
+}
+
+size_t AnimationSet::getOutputSize() const {
+	return outputSize;
+}
+
+const AnimationTrack& AnimationSet::getTrack(size_t track) const {
+	return tracks[track];
+}
+
+const float* AnimationSet::getTimes() const {
+	return times.data();
+}
+
+const float* AnimationSet::getValues() const {
+	return values.data();
+}
+
+const float* AnimationSet::getControls() const {
+	return controls.data();
+}
+
+AnimationSampler::AnimationSampler(const AnimationSet& animationSet)
+	: animationSet(animationSet), cursors(animationSet.getTrackCount(), 0), outputs(animationSet.getOutputSize(), 0.0f) {
+}
+
+void AnimationSampler::sample(float time) {
+	sampleRange(time, 0, animationSet.getTrackCount());
+}
+
+void AnimationSampler::sampleRange(float time, size_t beginTrack, size_t endTrack) {
+	for (size_t i = beginTrack; i < endTrack; ++i) {
+		const AnimationTrack& track = animationSet.getTrack(i);
+		float t = localTime(track, time);
+		cursors[i] = seekFrom(track, cursors[i], t);
+		evaluate(track, cursors[i], t);
+	}
+}
+
+void AnimationSampler::sampleUncached(float time) {
+	for (size_t i = 0; i < animationSet.getTrackCount(); ++i) {
+		const AnimationTrack& track = animationSet.getTrack(i);
+		float t = localTime(track, time);
+		evaluate(track, search(track, t), t);
+	}
+}
+
+const float* AnimationSampler::getOutput(size_t track) const {
+	return &outputs[animationSet.getTrack(track).outputOffset];
+}
+
+const std::vector<float>& AnimationSampler::getOutputs() const {
+	return outputs;
+}
+
+float AnimationSampler::localTime(const AnimationTrack& track, float time) const {
+	const float* times = animationSet.getTimes() + track.firstKey;
+	float start = times[0];
+	float end = times[track.keyCount - 1];
+	if (track.loop && end > start) {
+		float t = std::fmod(time - start, end - start);
+		return start + (t < 0.0f ? t + (end - start) : t);
+	}
+	return std::min(std::max(time, start), end);
+}
+
+uint32_t AnimationSampler::seekFrom(const AnimationTrack& track, uint32_t cursor, float time) const {
+	const float* times = animationSet.getTimes() + track.firstKey;
+	if (track.keyCount < 2) {
+		return 0;
+	}
+	if (cursor >= track.keyCount - 1 || times[cursor] > time) {
+		// time went backwards (loop wrap or seek), restart from the first key
+		cursor = 0;
+	}
+	while (cursor + 2 < track.keyCount && times[cursor + 1] <= time) {
+		++cursor;
+	}
+	return cursor;
+}
+
+uint32_t AnimationSampler::search(const AnimationTrack& track, float time) const {
+	if (track.keyCount < 2) {
+		return 0;
+	}
+	const float* times = animationSet.getTimes() + track.firstKey;
+	const float* upper = std::upper_bound(times, times + track.keyCount - 1, time);
+	return (uint32_t)std::max<std::ptrdiff_t>(0, (upper - times) - 1);
+}
+
+void AnimationSampler::evaluate(const AnimationTrack& track, uint32_t key, float time) {
+	const int components = track.components;
+	const float* values = animationSet.getValues() + track.valueOffset;
+	float* out = &outputs[track.outputOffset];
+	if (track.keyCount < 2) {
+		for (int c = 0; c < components; ++c) {
+			out[c] = values[c];
+		}
+		return;
+	}
+
+	const float* times = animationSet.getTimes() + track.firstKey;
+	uint32_t next = key + 1;
+	float span = times[next] - times[key];
+	float u = span > 0.0f ? (time - times[key]) / span : 0.0f;
+	u = std::min(std::max(u, 0.0f), 1.0f);
+	const float* p1 = values + key * components;
+	const float* p2 = values + next * components;
+
+	switch (track.interpolation) {
+	case Interpolation::Linear:
+		for (int c = 0; c < components; ++c) {
+			out[c] = p1[c] + (p2[c] - p1[c]) * u;
+		}
+		break;
+	case Interpolation::CatmullRom: {
+		// neighbours are clamped at the ends of the track
+		const float* p0 = values + (key > 0 ? key - 1 : key) * components;
+		const float* p3 = values + (next + 1 < track.keyCount ? next + 1 : next) * components;
+		float u2 = u * u;
+		float u3 = u2 * u;
+		for (int c = 0; c < components; ++c) {
+			out[c] = 0.5f * (2.0f * p1[c] + (p2[c] - p0[c]) * u
+				+ (2.0f * p0[c] - 5.0f * p1[c] + 4.0f * p2[c] - p3[c]) * u2
+				+ (3.0f * p1[c] - p0[c] - 3.0f * p2[c] + p3[c]) * u3);
+		}
+		break;
+	}
+	case Interpolation::Bezier: {
+		// per key: in control point, then out control point
+		const float* controls = animationSet.getControls() + track.controlOffset;
+		const float* c1 = controls + (key * 2 + 1) * components;
+		const float* c2 = controls + (next * 2) * components;
+		float v = 1.0f - u;
+		float b0 = v * v * v;
+		float b1 = 3.0f * v * v * u;
+		float b2 = 3.0f * v * u * u;
+		float b3 = u * u * u;
+		for (int c = 0; c < components; ++c) {
+			out[c] = b0 * p1[c] + b1 * c1[c] + b2 * c2[c] + b3 * p2[c];
+		}
+		break;
+	}
+	}
+}
@@ -0,0 +1,37 @@
+#include <board_generator.hpp>
+
+#include <cstddef>
+
+void BoardGenerator::appendBoard(std::vector<float>& vertices, std::vector<unsigned int>& indices,
+	int boardSize, float startX, float startY, float squareSize) {
+	unsigned int current_vertex_offset = vertices.size() / 6;
+	const size_t squareCount = (size_t)boardSize * boardSize;
+	vertices.reserve(vertices.size() + squareCount * 24);
+	indices.reserve(indices.size() + squareCount * 6);
+
+	for (int row = 0; row < boardSize; ++row) {
+		for (int col = 0; col < boardSize; ++col) {
+			float x_square_bl = startX + col * squareSize;
+			float y_square_bl = startY + row * squareSize;
+			float r, g, b;
+			if ((row + col) % 2 == 0) {
+				// w
+				r = 1.0f; g = 1.0f; b = 1.0f;
+			} else {
+				// b
+				r = 0.1f; g = 0.1f; b = 0.1f;
+			}
+			vertices.insert(vertices.end(), {
+				x_square_bl, y_square_bl, 0.0f, r, g, b,
+				x_square_bl + squareSize, y_square_bl, 0.0f, r, g, b,
+				x_square_bl + squareSize, y_square_bl + squareSize, 0.0f, r, g, b,
+				x_square_bl, y_square_bl + squareSize, 0.0f, r, g, b
+			});
+			indices.insert(indices.end(), {
+				current_vertex_offset + 0, current_vertex_offset + 1, current_vertex_offset + 2,
+				current_vertex_offset + 0, current_vertex_offset + 2, current_vertex_offset + 3
+			});
+			current_vertex_offset += 4;
+		}
+	}
+}
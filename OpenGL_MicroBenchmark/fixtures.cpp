@@ -0,0 +1,218 @@
+#include <fixtures.hpp>
+#include <animation.hpp>
+#include <board_generator.hpp>
+#include <scene_file.hpp>
+#include <shader_manager.hpp>
+#include <shape_generator.hpp>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <img/stb_image.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <streambuf>
+#include <vector>
+
+namespace Fixtures {
+	static bool fileExists(const std::string& path) {
+		return std::ifstream(path).good();
+	}
+
+	// Discards everything without allocating, so it doesn't show up in the counts
+	class NullBuffer : public std::streambuf {
+	protected:
+		int overflow(int c) override { return c; }
+	};
+
+	// ShaderManager reports every successful load on stdout
+	class SilenceOutput {
+	public:
+		SilenceOutput() : previous(std::cout.rdbuf(&sink)) {}
+		~SilenceOutput() { std::cout.rdbuf(previous); }
+
+	private:
+		static NullBuffer sink;
+		std::streambuf* previous;
+	};
+
+	NullBuffer SilenceOutput::sink;
+
+	static void addShaderFixtures(MicroBenchmark& benchmark, const std::string& repoDirectory) {
+		struct ShaderPair {
+			const char* name;
+			const char* vertex;
+			const char* fragment;
+		};
+		const ShaderPair pairs[] = {
+			{ "shader/load basics", "OpenGL_Basics/shaders/vertex.glsl", "OpenGL_Basics/shaders/fragment.glsl" },
+			{ "shader/load scenery", "OpenGL_Scenery/shaders/vertex.glsl", "OpenGL_Scenery/shaders/fragment.glsl" },
+			{ "shader/load wave", "OpenGL_Wave/shaders/vertex.glsl", "OpenGL_Wave/shaders/fragment.glsl" },
+		};
+		for (const ShaderPair& pair : pairs) {
+			std::string vertexPath = repoDirectory + "/" + pair.vertex;
+			std::string fragmentPath = repoDirectory + "/" + pair.fragment;
+			if (!fileExists(vertexPath) || !fileExists(fragmentPath)) {
+				std::cout << pair.name << ": skipped, missing " << vertexPath << std::endl;
+				continue;
+			}
+			std::shared_ptr<ShaderManager> shaderManager;
+			{
+				SilenceOutput silence;
+				shaderManager = std::make_shared<ShaderManager>(vertexPath, fragmentPath);
+			}
+			benchmark.add(pair.name, [shaderManager]() {
+				SilenceOutput silence;
+				shaderManager->loadShaders();
+				MicroBenchmark::keep((double)shaderManager->getShaderProgram());
+			});
+		}
+	}
+
+	static void addGeometryFixtures(MicroBenchmark& benchmark) {
+		for (int boardSize : { 8, 64, 256 }) {
+			benchmark.add("basics/board size=" + std::to_string(boardSize), [boardSize]() {
+				std::vector<float> vertices;
+				std::vector<unsigned int> indices;
+				BoardGenerator::appendBoard(vertices, indices, boardSize, -1.0f, -1.0f, 2.0f / boardSize);
+				MicroBenchmark::keep(vertices.data());
+				MicroBenchmark::keep(indices.data());
+			});
+		}
+		for (int segments : { 100, 10000, 100000 }) {
+			benchmark.add("shapes/circle segments=" + std::to_string(segments), [segments]() {
+				std::vector<float> vertices;
+				std::vector<unsigned int> indices;
+				ShapeGenerator::appendCircle(vertices, indices, -0.6f, -0.45f, 0.25f, segments, 1.0f, 1.0f, 0.0f);
+				MicroBenchmark::keep(vertices.data());
+				MicroBenchmark::keep(indices.data());
+			});
+		}
+		// the Shapes scene: circle, pentagon and hexagon into one buffer
+		benchmark.add("shapes/scene", []() {
+			std::vector<float> vertices;
+			std::vector<unsigned int> indices;
+			ShapeGenerator::appendCircle(vertices, indices, -0.6f, -0.45f, 0.25f, 100, 1.0f, 1.0f, 0.0f);
+			ShapeGenerator::appendRegularPolygon(vertices, indices, 0.0f, -0.45f, 0.2f, 5, 3.1415926f / 2.0f, 0.5f, 0.0f, 1.0f);
+			ShapeGenerator::appendRegularPolygon(vertices, indices, 0.5f, -0.45f, 0.2f, 6, 0.0f, 1.0f, 0.5f, 0.0f);
+			MicroBenchmark::keep(vertices.data());
+			MicroBenchmark::keep(indices.data());
+		});
+	}
+
+	static void addImageFixtures(MicroBenchmark& benchmark, const std::string& repoDirectory) {
+		const char* images[] = { "red_brick_diff_4k.jpg", "wooden_garage_door_diff_4k.jpg" };
+		for (const char* image : images) {
+			std::string path = repoDirectory + "/OpenGL_Scenery/assets/" + image;
+			std::string name = std::string("image/stbi_load ") + image;
+			if (!fileExists(path)) {
+				std::cout << name << ": skipped, missing " << path << std::endl;
+				continue;
+			}
+			benchmark.add(name, [path]() {
+				int width, height, channels;
+				unsigned char* data = stbi_load(path.c_str(), &width, &height, &channels, 0);
+				MicroBenchmark::keep(data);
+				stbi_image_free(data);
+			});
+		}
+	}
+
+	// Transformations' per-frame loop: sample position, rotation and scale
+	// tracks, then compose each square's model matrix with glm
+	static void addTransformFixtures(MicroBenchmark& benchmark) {
+		const glm::vec3 waypoints[] = {
+			glm::vec3(-0.75f, 0.75f, 0.0f),
+			glm::vec3(0.75f, 0.75f, 0.0f),
+			glm::vec3(0.75f, -0.75f, 0.0f),
+			glm::vec3(-0.75f, -0.75f, 0.0f)
+		};
+		for (int squareCount : { 4, 1000, 10000 }) {
+			std::shared_ptr<AnimationSet> animationSet = std::make_shared<AnimationSet>();
+			for (int i = 0; i < squareCount; i++) {
+				glm::vec3 startPos = waypoints[i % 4];
+				glm::vec3 endPos = waypoints[(i + 1) % 4];
+				animationSet->addTrack(TrackTarget::Position, Interpolation::Linear, 3, true,
+					{ 0.0f, 2.0f }, { startPos.x, startPos.y, startPos.z, endPos.x, endPos.y, endPos.z });
+				animationSet->addTrack(TrackTarget::Rotation, Interpolation::Linear, 1, true,
+					{ 0.0f, 4.0f }, { 0.0f, glm::radians(360.0f) });
+				animationSet->addTrack(TrackTarget::Scale, Interpolation::Linear, 3, false,
+					{ 0.0f }, { 0.25f, 0.25f, 0.25f });
+			}
+			std::shared_ptr<AnimationSampler> sampler = std::make_shared<AnimationSampler>(*animationSet);
+			std::shared_ptr<std::vector<glm::mat4>> models = std::make_shared<std::vector<glm::mat4>>(squareCount);
+			std::shared_ptr<float> time = std::make_shared<float>(0.0f);
+			benchmark.add("transformations/glm loop squares=" + std::to_string(squareCount),
+				[animationSet, sampler, models, time, squareCount]() {
+				*time += 1.0f / 60.0f;
+				sampler->sample(*time);
+				for (int i = 0; i < squareCount; i++) {
+					const float* position = sampler->getOutput(i * 3 + 0);
+					const float* angle = sampler->getOutput(i * 3 + 1);
+					const float* scale = sampler->getOutput(i * 3 + 2);
+					glm::mat4 model = glm::mat4(1.0f);
+					model = glm::translate(model, glm::vec3(position[0], position[1], position[2]));
+					model = glm::rotate(model, angle[0], glm::vec3(0.0f, 0.0f, 1.0f));
+					model = glm::scale(model, glm::vec3(scale[0], scale[1], scale[2]));
+					(*models)[i] = model;
+				}
+				MicroBenchmark::keep(models->data());
+			});
+		}
+	}
+
+	// A generated grid scene of just over a million vertices, loaded from its
+	// text form and from the compiled binary; both files go to the working directory
+	static void addSceneFixtures(MicroBenchmark& benchmark) {
+		const int gridSize = 1024;
+		const int meshRows = 64;
+		std::string textPath = "micro_scene.scene";
+		std::string binaryPath = "micro_scene.sceneb";
+		{
+			std::ofstream text(textPath);
+			text << "layout 6\n";
+			for (int mesh = 0; mesh < gridSize / meshRows; ++mesh) {
+				text << "mesh rows_" << mesh << "\nmaterial 0\n";
+				for (int y = 0; y <= meshRows; ++y) {
+					for (int x = 0; x < gridSize; ++x) {
+						text << "v " << x / (float)gridSize << " " << (mesh * meshRows + y) / (float)gridSize
+							<< " 0 1 " << x % 2 << " 0.5\n";
+					}
+				}
+				for (int y = 0; y < meshRows; ++y) {
+					for (int x = 0; x + 1 < gridSize; ++x) {
+						unsigned int corner = y * gridSize + x;
+						text << "i " << corner << " " << corner + 1 << " " << corner + gridSize
+							<< " " << corner + 1 << " " << corner + gridSize + 1 << " " << corner + gridSize << "\n";
+					}
+				}
+			}
+		}
+		std::string error;
+		if (!SceneFile::compile(textPath, binaryPath, error)) {
+			std::cout << "scene/load: skipped, " << error << std::endl;
+			return;
+		}
+		const std::pair<const char*, std::string> forms[] = { { "scene/load text 1M vertices", textPath }, { "scene/load binary 1M vertices", binaryPath } };
+		for (const auto& form : forms) {
+			std::string path = form.second;
+			benchmark.add(form.first, [path]() {
+				SceneFile scene;
+				std::string error;
+				scene.load(path, error);
+				MicroBenchmark::keep(scene.getVertices());
+				MicroBenchmark::keep(scene.getIndices());
+			});
+		}
+	}
+
+	void addAll(MicroBenchmark& benchmark, const std::string& repoDirectory) {
+		addShaderFixtures(benchmark, repoDirectory);
+		addGeometryFixtures(benchmark);
+		addImageFixtures(benchmark, repoDirectory);
+		addTransformFixtures(benchmark);
+		addSceneFixtures(benchmark);
+	}
+}
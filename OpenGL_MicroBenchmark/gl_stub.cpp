@@ -0,0 +1,56 @@
+#include <gl_stub.hpp>
+
+namespace GlStub {
+	static size_t callCount = 0;
+	static GLuint nextName = 1;
+
+	static GLuint APIENTRY createShader(GLenum) { ++callCount; return nextName++; }
+	static GLuint APIENTRY createProgram() { ++callCount; return nextName++; }
+	static void APIENTRY shaderSource(GLuint, GLsizei, const GLchar* const*, const GLint*) { ++callCount; }
+	static void APIENTRY compileShader(GLuint) { ++callCount; }
+	static void APIENTRY attachShader(GLuint, GLuint) { ++callCount; }
+	static void APIENTRY linkProgram(GLuint) { ++callCount; }
+	static void APIENTRY useProgram(GLuint) { ++callCount; }
+	static void APIENTRY deleteShader(GLuint) { ++callCount; }
+	static void APIENTRY deleteProgram(GLuint) { ++callCount; }
+
+	static void APIENTRY getShaderiv(GLuint, GLenum, GLint* params) {
+		++callCount;
+		*params = GL_TRUE;
+	}
+
+	static void APIENTRY getProgramiv(GLuint, GLenum, GLint* params) {
+		++callCount;
+		*params = GL_TRUE;
+	}
+
+	static void APIENTRY getInfoLog(GLuint, GLsizei bufSize, GLsizei* length, GLchar* infoLog) {
+		++callCount;
+		if (length != nullptr) {
+			*length = 0;
+		}
+		if (bufSize > 0) {
+			infoLog[0] = '\0';
+		}
+	}
+
+	void install() {
+		glad_glCreateShader = createShader;
+		glad_glCreateProgram = createProgram;
+		glad_glShaderSource = shaderSource;
+		glad_glCompileShader = compileShader;
+		glad_glAttachShader = attachShader;
+		glad_glLinkProgram = linkProgram;
+		glad_glUseProgram = useProgram;
+		glad_glDeleteShader = deleteShader;
+		glad_glDeleteProgram = deleteProgram;
+		glad_glGetShaderiv = getShaderiv;
+		glad_glGetProgramiv = getProgramiv;
+		glad_glGetShaderInfoLog = getInfoLog;
+		glad_glGetProgramInfoLog = getInfoLog;
+	}
+
+	size_t getCallCount() {
+		return callCount;
+	}
+}
@@ -0,0 +1,107 @@
+#include <import_benchmark.hpp>
+#include <allocation_counter.hpp>
+#include <mesh_importer.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+
+ImportBenchmark::ImportBenchmark(const std::vector<int>& threadCounts, int repeats)
+	: threadCounts(threadCounts), repeats(std::max(1, repeats)) {}
+
+bool ImportBenchmark::run(const std::string& path) {
+	std::printf("%-8s %12s %10s %12s %10s %8s %12s %12s\n",
+		"threads", "parse ms", "MB/s", "build ms", "peak MB", "meshes", "vertices", "triangles");
+	for (int threadCount : threadCounts) {
+		ImportOptions options;
+		options.threadCount = threadCount;
+		MeshImporter importer(options);
+		// best of repeats for the times, the peak is the same every time
+		ImportStats best = {};
+		size_t peakBytes = 0;
+		for (int repeat = 0; repeat < repeats; ++repeat) {
+			ImportedModel model;
+			std::string error;
+			AllocationCounter::resetPeak();
+			size_t liveBefore = AllocationCounter::getLiveBytes();
+			if (!importer.parse(path, model, error)) {
+				std::cerr << "Import failed: " << error << std::endl;
+				return false;
+			}
+			peakBytes = AllocationCounter::getPeakBytes() - liveBefore;
+			const ImportStats& stats = importer.getStats();
+			if (repeat == 0 || stats.parseMs + stats.buildMs < best.parseMs + best.buildMs) {
+				best = stats;
+			}
+		}
+		std::printf("%-8d %12.1f %10.1f %12.1f %10.1f %8zu %12zu %12zu\n", threadCount, best.parseMs,
+			best.getParseMegabytesPerSecond(), best.buildMs, peakBytes / (1024.0 * 1024.0), best.meshCount,
+			best.vertexCount, best.indexCount / 3);
+	}
+
+	// the cache, first written and then reused
+	ImportOptions options;
+	options.threadCount = threadCounts.empty() ? 0 : threadCounts.back();
+	options.cacheDirectory = (std::filesystem::temp_directory_path() / "import_benchmark_cache").string();
+	MeshImporter importer(options);
+	std::string cachePath = importer.getCachePath(path);
+	std::error_code errorCode;
+	std::filesystem::remove(cachePath, errorCode);
+	std::string error;
+	SceneFile cold, warm;
+	if (!importer.import(path, cold, error)) {
+		std::cerr << "Import failed: " << error << std::endl;
+		return false;
+	}
+	ImportStats first = importer.getStats();
+	AllocationCounter::resetPeak();
+	size_t liveBefore = AllocationCounter::getLiveBytes();
+	if (!importer.import(path, warm, error)) {
+		std::cerr << "Import failed: " << error << std::endl;
+		return false;
+	}
+	ImportStats second = importer.getStats();
+	std::printf("cache: %.1f MB source, first import %.1f ms (write %.1f ms), cached import %.3f ms %s, %.2f MB peak heap\n",
+		first.sourceBytes / (1024.0 * 1024.0), first.parseMs + first.buildMs + first.writeMs + first.loadMs, first.writeMs,
+		second.loadMs, second.cacheHit ? "(mapped)" : "(missed)",
+		(AllocationCounter::getPeakBytes() - liveBefore) / (1024.0 * 1024.0));
+	std::filesystem::remove(cachePath, errorCode);
+	return true;
+}
+
+bool ImportBenchmark::generateObj(const std::string& path, int megabytes) {
+	std::FILE* file = std::fopen(path.c_str(), "wb");
+	if (file == nullptr) {
+		return false;
+	}
+	// one row: a vertex line (~52 bytes) and a face line (~36 bytes) per column
+	const int columns = 1024;
+	const size_t bytesPerRow = columns * 88;
+	int rows = std::max(2, (int)((size_t)megabytes * 1024 * 1024 / bytesPerRow));
+	int rowsPerObject = std::max(1, rows / 64);
+	std::fprintf(file, "# %d x %d grid\n", columns, rows);
+	for (int column = 0; column < columns; ++column) {
+		std::fprintf(file, "vt %.6f 0.000000\n", column / (float)(columns - 1));
+	}
+	for (int row = 0; row < rows; ++row) {
+		if (row % rowsPerObject == 0) {
+			std::fprintf(file, "o rows_%d\nusemtl material_%d\n", row / rowsPerObject, row / rowsPerObject % 2);
+		}
+		for (int column = 0; column < columns; ++column) {
+			std::fprintf(file, "v %.6f %.6f %.6f %.4f %.4f %.4f\n", column / (float)columns, row / (float)rows,
+				0.01f * ((column * 7 + row * 13) % 17), (column % 5) / 4.0f, (row % 3) / 2.0f, 0.5f);
+		}
+		if (row == 0) {
+			continue;
+		}
+		// quads between this row and the last, by relative index
+		for (int column = 0; column + 1 < columns; ++column) {
+			int here = column - columns, previous = column - 2 * columns;
+			std::fprintf(file, "f %d/%d %d/%d %d/%d %d/%d\n", previous, column + 1, previous + 1, column + 2,
+				here + 1, column + 2, here, column + 1);
+		}
+	}
+	bool written = std::ferror(file) == 0;
+	return std::fclose(file) == 0 && written;
+}
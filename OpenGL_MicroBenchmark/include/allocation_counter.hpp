@@ -0,0 +1,20 @@
+#pragma once
+
+#ifndef ALLOCATION_COUNTER_HPP
+#define ALLOCATION_COUNTER_HPP
+
+#include <cstddef>
+
+// allocation_counter.cpp replaces the global operator new and delete for the
+// whole program; these read its running totals. Differences between two
+// reads give the heap traffic of the code in between.
+namespace AllocationCounter {
+	size_t getAllocationCount();
+	size_t getAllocatedBytes();
+	// bytes allocated and not yet freed, and the most there has been since resetPeak()
+	size_t getLiveBytes();
+	size_t getPeakBytes();
+	void resetPeak();
+}
+
+#endif
@@ -0,0 +1,93 @@
+#pragma once
+
+#ifndef ANIMATION_HPP
+#define ANIMATION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+enum class TrackTarget {
+	Position,
+	Rotation,
+	Scale
+};
+
+enum class Interpolation {
+	Linear,
+	CatmullRom,
+	Bezier
+};
+
+// A track is a slice of the shared key arrays, so each track's keys are contiguous.
+struct AnimationTrack {
+	TrackTarget target;
+	Interpolation interpolation;
+	int components;
+	bool loop;
+	uint32_t firstKey;
+	uint32_t keyCount;
+	// offsets into the value, control point and output arrays
+	uint32_t valueOffset;
+	uint32_t controlOffset;
+	uint32_t outputOffset;
+};
+
+// Owns the keyframes of many tracks. Rotation tracks hold one angle about z,
+// position and scale tracks hold three components.
+class AnimationSet {
+public:
+	AnimationSet();
+	~AnimationSet() = default;
+
+	static const size_t INVALID_TRACK = (size_t)-1;
+
+	// times must be increasing; values hold components floats per key. Bezier
+	// tracks also take controls: an in and an out control point per key.
+	// Returns INVALID_TRACK and adds nothing when the keys break these rules.
+	size_t addTrack(TrackTarget target, Interpolation interpolation, int components, bool loop,
+		const std::vector<float>& times, const std::vector<float>& values,
+		const std::vector<float>& controls = std::vector<float>());
+
+	size_t getTrackCount() const;
+	size_t getOutputSize() const;
+	const AnimationTrack& getTrack(size_t track) const;
+	const float* getTimes() const;
+	const float* getValues() const;
+	const float* getControls() const;
+
+private:
+	std::vector<AnimationTrack> tracks;
+	std::vector<float> times;
+	std::vector<float> values;
+	std::vector<float> controls;
+	uint32_t outputSize;
+};
+
+// Samples every track of a set at one time. Each track keeps a cursor to the
+// key it sampled last, so advancing time only steps forward a key or two.
+class AnimationSampler {
+public:
+	AnimationSampler(const AnimationSet& animationSet);
+	~AnimationSampler() = default;
+
+	void sample(float time);
+	void sampleRange(float time, size_t beginTrack, size_t endTrack);
+	// Same result through a binary search per track, for comparison
+	void sampleUncached(float time);
+
+	const float* getOutput(size_t track) const;
+	const std::vector<float>& getOutputs() const;
+
+private:
+	float localTime(const AnimationTrack& track, float time) const;
+	uint32_t seekFrom(const AnimationTrack& track, uint32_t cursor, float time) const;
+	uint32_t search(const AnimationTrack& track, float time) const;
+	void evaluate(const AnimationTrack& track, uint32_t key, float time);
+
+	const AnimationSet& animationSet;
+	std::vector<uint32_t> cursors;
+	std::vector<float> outputs;
+};
+
+#endif
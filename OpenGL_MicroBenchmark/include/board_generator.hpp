@@ -0,0 +1,16 @@
+#pragma once
+
+#ifndef BOARD_GENERATOR_HPP
+#define BOARD_GENERATOR_HPP
+
+#include <vector>
+
+// Chessboard quads for the 6-float (position + color) vertex layout.
+namespace BoardGenerator {
+	// boardSize x boardSize squares of squareSize starting at (startX, startY),
+	// row by row from the bottom; (0, 0) is white. Four vertices and six indices per square.
+	void appendBoard(std::vector<float>& vertices, std::vector<unsigned int>& indices,
+		int boardSize, float startX, float startY, float squareSize);
+}
+
+#endif
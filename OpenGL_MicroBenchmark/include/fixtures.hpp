@@ -0,0 +1,20 @@
+#pragma once
+
+#ifndef FIXTURES_HPP
+#define FIXTURES_HPP
+
+#include <micro_benchmark.hpp>
+
+#include <string>
+
+// The CPU-side hot paths of the demos, each as it runs in its demo:
+// shader file loading, the Basics board and Shapes fan generators, stbi_load
+// of Scenery's 4k textures, the Transformations sample-and-compose loop and
+// a million-vertex scene loaded from text and from the compiled binary.
+// repoDirectory is the checkout holding the OpenGL_* folders; fixtures whose
+// input files are missing there are skipped with a note.
+namespace Fixtures {
+	void addAll(MicroBenchmark& benchmark, const std::string& repoDirectory);
+}
+
+#endif
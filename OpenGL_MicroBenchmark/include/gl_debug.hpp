@@ -0,0 +1,78 @@
+#pragma once
+
+#ifndef GL_DEBUG_HPP
+#define GL_DEBUG_HPP
+
+#include <glad/glad.h>
+
+// The layer is built into debug builds; with NDEBUG every call below is an
+// empty inline and the translation unit compiles to nothing. Define
+// GL_DEBUG_LAYER to keep it in an optimized build.
+#if !defined(NDEBUG) && !defined(GL_DEBUG_LAYER)
+#define GL_DEBUG_LAYER
+#endif
+
+// Command line options for the debug layer, read in debug builds only:
+// --gl-debug-notifications also collects notification severity messages,
+// --gl-debug-limit N prints at most N new messages a frame (default 8); the rest are still counted
+struct GlDebugOptions {
+	bool notifications;
+	int printLimit;
+
+	static GlDebugOptions parse(int argc, char** argv);
+};
+
+// KHR_debug message capture (core since 4.3). install() asks the driver for
+// every error, performance and portability message through a synchronous
+// callback, so a message arrives on the GL thread inside the call that
+// caused it. Each distinct message is printed the first time it is seen,
+// at most printLimit a frame, and counted every time; repeats only count.
+//
+// Messages are attributed to the innermost zone open when they arrived
+// (GlDebugZone, also a debug group for capture tools) and, when the text
+// names an object that was labelled, to that label. label() also hands the
+// name to glObjectLabel so the driver's own messages use it. endFrame()
+// closes the frame's counts and report() prints the totals and the most
+// frequent messages.
+//
+// Without a debug context most drivers send errors only; the contexts here
+// ask for one whenever the layer is built. GL thread only.
+class GlDebug {
+public:
+	static const int MAX_ZONE_DEPTH = 16;
+	static const int REPORT_TOP = 10;
+
+	// Whether to request a debug context; call before creating one
+	static bool wantsDebugContext();
+	// Call once glad is loaded
+	static void install(const GlDebugOptions& options);
+	// Call after the object's first bind (a generated name is not an object before it)
+	static void label(GLenum identifier, GLuint name, const char* text);
+	// name must outlive the layer, a string literal in practice
+	static void pushZone(const char* name);
+	static void popZone();
+	static void endFrame();
+	static void report();
+};
+
+// Attributes the GL calls of a scope to a zone
+class GlDebugZone {
+public:
+	GlDebugZone(const char* name) { GlDebug::pushZone(name); }
+	~GlDebugZone() { GlDebug::popZone(); }
+	GlDebugZone(const GlDebugZone&) = delete;
+	GlDebugZone& operator=(const GlDebugZone&) = delete;
+};
+
+#ifndef GL_DEBUG_LAYER
+inline GlDebugOptions GlDebugOptions::parse(int, char**) { return GlDebugOptions{ false, 0 }; }
+inline bool GlDebug::wantsDebugContext() { return false; }
+inline void GlDebug::install(const GlDebugOptions&) {}
+inline void GlDebug::label(GLenum, GLuint, const char*) {}
+inline void GlDebug::pushZone(const char*) {}
+inline void GlDebug::popZone() {}
+inline void GlDebug::endFrame() {}
+inline void GlDebug::report() {}
+#endif
+
+#endif
@@ -0,0 +1,19 @@
+#pragma once
+
+#ifndef GL_STUB_HPP
+#define GL_STUB_HPP
+
+#include <glad/glad.h>
+
+#include <cstddef>
+
+// Points the glad entry points the CPU-side code calls at no-op stand-ins, so
+// ShaderManager and friends run without a context. Object creation hands out
+// increasing names, compile and link status queries report success, and every
+// call is counted.
+namespace GlStub {
+	void install();
+	size_t getCallCount();
+}
+
+#endif
@@ -0,0 +1,29 @@
+#pragma once
+
+#ifndef IMPORT_BENCHMARK_HPP
+#define IMPORT_BENCHMARK_HPP
+
+#include <string>
+#include <vector>
+
+// Imports one model with MeshImporter at each thread count and prints parse
+// throughput, build time and peak heap use, then the cost of writing the
+// compiled cache and of importing again from it. Meant for models of a few
+// hundred MB; generateObj() writes one when there is none at hand.
+class ImportBenchmark {
+public:
+	ImportBenchmark(const std::vector<int>& threadCounts, int repeats);
+	~ImportBenchmark() = default;
+
+	// Returns false if the model can't be imported
+	bool run(const std::string& path);
+
+	// A grid of textured, vertex-colored quads in 64 objects, close to megabytes in size
+	static bool generateObj(const std::string& path, int megabytes);
+
+private:
+	std::vector<int> threadCounts;
+	int repeats;
+};
+
+#endif
@@ -0,0 +1,89 @@
+#pragma once
+
+#ifndef MESH_IMPORTER_HPP
+#define MESH_IMPORTER_HPP
+
+#include <scene_file.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct ImportOptions {
+	// 6 is position xyz, color rgb; 9 is position xyz, color rgba, texture coordinates uv
+	int floatsPerVertex = 9;
+	// centers the model and scales it into [-0.9, 0.9] on x and y and [-0.5, 0.5] on z
+	bool fitToView = true;
+	// 0 uses every hardware thread
+	int threadCount = 0;
+	// the file is read this many bytes per worker at a time
+	size_t chunkBytes = 4 << 20;
+	// compiled scenes are cached here; empty puts them next to the model
+	std::string cacheDirectory;
+};
+
+struct ImportStats {
+	size_t sourceBytes;
+	int threadCount;
+	bool cacheHit;
+	// reading and tokenizing, then de-indexing and building the vertex layout, then the cache write
+	double parseMs;
+	double buildMs;
+	double writeMs;
+	double loadMs;
+	size_t meshCount;
+	size_t vertexCount;
+	size_t indexCount;
+
+	double getParseMegabytesPerSecond() const;
+};
+
+// Geometry as the importer builds it, in SceneFile's arrangement
+struct ImportedModel {
+	int floatsPerVertex = 0;
+	std::vector<SceneMesh> meshes;
+	std::vector<float> vertices;
+	std::vector<uint32_t> indices;
+};
+
+// Imports Wavefront OBJ and glTF 2.0 (.gltf with external or base64 buffers,
+// or .glb) into the demos' vertex layouts.
+//
+// OBJ is streamed: each round reads chunkBytes per worker, cuts the block at
+// line ends and tokenizes the pieces on their own threads. Every o, g or
+// usemtl starts a mesh; faces are fanned into triangles and each distinct
+// position/texcoord pair becomes one vertex, with meshes re-indexed in
+// parallel. "v x y z r g b" vertex colors are kept, normals are dropped.
+//
+// glTF meshes are placed by the default scene's node transforms; triangle
+// primitives only, without sparse accessors. Each primitive becomes a mesh
+// whose material is the primitive's material index.
+//
+// import() writes the result as a compiled scene named after the model's
+// size and modification time plus the options, and maps it; importing the
+// same unchanged file again only maps the cache.
+class MeshImporter {
+public:
+	static const uint32_t CACHE_VERSION = 1;
+
+	explicit MeshImporter(const ImportOptions& options);
+
+	// Uses or refreshes the cache, then loads it into scene
+	bool import(const std::string& path, SceneFile& scene, std::string& error);
+	// Parses and builds without touching the cache
+	bool parse(const std::string& path, ImportedModel& model, std::string& error);
+	std::string getCachePath(const std::string& path) const;
+	const ImportStats& getStats() const;
+
+private:
+	bool parseObj(const std::string& path, ImportedModel& model, std::string& error);
+	bool parseGltf(const std::string& path, ImportedModel& model, std::string& error);
+	void fitToView(ImportedModel& model) const;
+	int getThreadCount() const;
+
+	ImportOptions options;
+	ImportStats stats;
+};
+
+#endif
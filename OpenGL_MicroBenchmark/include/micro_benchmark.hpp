@@ -0,0 +1,56 @@
+#pragma once
+
+#ifndef MICRO_BENCHMARK_HPP
+#define MICRO_BENCHMARK_HPP
+
+#include <functional>
+#include <string>
+#include <vector>
+
+struct MicroResult {
+	std::string name;
+	size_t iterations;      // per sample
+	size_t samples;
+	double medianNs;        // per iteration
+	double meanNs;
+	double minNs;
+	double stddevNs;
+	double allocationsPerIteration;
+	double bytesPerIteration;
+};
+
+// Times small CPU-side fixtures. Each fixture's iteration count is doubled
+// until one sample takes at least minSampleMs, then sampleCount samples are
+// taken; timings are per iteration and heap traffic comes from the counting
+// operator new in allocation_counter.cpp.
+class MicroBenchmark {
+public:
+	MicroBenchmark(double minSampleMs, int sampleCount);
+	~MicroBenchmark() = default;
+
+	// body runs one iteration and should hand its result to keep() so the
+	// compiler can't drop the work
+	void add(const std::string& name, const std::function<void()>& body);
+	// Runs every fixture whose name contains filter (all if empty) and prints a table
+	void run(const std::string& filter);
+	bool writeJson(const std::string& path) const;
+	const std::vector<MicroResult>& getResults() const;
+
+	static void keep(const void* pointer);
+	static void keep(double value);
+
+private:
+	MicroResult measure(const std::string& name, const std::function<void()>& body) const;
+
+	struct Fixture {
+		std::string name;
+		std::function<void()> body;
+	};
+
+	double minSampleMs;
+	int sampleCount;
+	std::vector<Fixture> fixtures;
+	std::vector<MicroResult> results;
+};
+
+#endif
@@ -0,0 +1,109 @@
+#pragma once
+
+#ifndef SCENE_FILE_HPP
+#define SCENE_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// A mesh's slice of the scene's shared vertex and index arrays. Indices are
+// local to the mesh, so draws add baseVertex.
+struct SceneMesh {
+	std::string name;
+	int32_t material;
+	uint32_t baseVertex;
+	uint32_t vertexCount;
+	uint32_t firstIndex;
+	uint32_t indexCount;
+};
+
+// Compiled form. Little-endian, every section starts on a 256 byte boundary:
+// header | mesh records | vertex floats | uint32 indices
+struct SceneBinaryHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t floatsPerVertex;
+	uint32_t meshCount;
+	uint32_t reserved;
+	uint64_t meshOffset;
+	uint64_t vertexOffset;
+	uint64_t vertexBytes;
+	uint64_t indexOffset;
+	uint64_t indexBytes;
+};
+
+struct SceneMeshRecord {
+	char name[48];
+	int32_t material;
+	uint32_t baseVertex;
+	uint32_t vertexCount;
+	uint32_t firstIndex;
+	uint32_t indexCount;
+	uint32_t reserved[3];
+};
+
+// Scene geometry loaded from either form. The text form is line based:
+//   layout N             floats per vertex, first
+//   mesh NAME            starts a mesh
+//   material N           optional, the demo decides what it means
+//   v f f f ...          one vertex, N floats
+//   i a b c ...          indices, local to the mesh
+// with # comments. The binary form is memory mapped, so getVertices() and
+// getIndices() point straight into the file and can be handed to
+// glBufferStorage as they are.
+class SceneFile {
+public:
+	static const uint32_t VERSION = 1;
+	static const size_t ALIGNMENT = 256;
+
+	SceneFile();
+	~SceneFile();
+	SceneFile(const SceneFile&) = delete;
+	SceneFile& operator=(const SceneFile&) = delete;
+
+	// Picks the form from the file's first bytes; returns false and fills error on failure
+	bool load(const std::string& path, std::string& error);
+	// Reads a text scene and writes its compiled form
+	static bool compile(const std::string& textPath, const std::string& binaryPath, std::string& error);
+	// Writes the compiled form of geometry built elsewhere, e.g. by an importer;
+	// names are cut to 47 characters
+	static bool write(const std::string& binaryPath, int floatsPerVertex, const std::vector<SceneMesh>& meshes,
+		const float* vertices, size_t vertexCount, const uint32_t* indices, size_t indexCount, std::string& error);
+
+	bool isMapped() const;
+	int getFloatsPerVertex() const;
+	const float* getVertices() const;
+	size_t getVertexCount() const;
+	size_t getVertexBytes() const;
+	const uint32_t* getIndices() const;
+	size_t getIndexCount() const;
+	size_t getIndexBytes() const;
+	const std::vector<SceneMesh>& getMeshes() const;
+	// nullptr if there is no mesh of that name
+	const SceneMesh* findMesh(const std::string& name) const;
+
+private:
+	bool parseText(const std::string& path, std::string& error);
+	bool mapBinary(const std::string& path, std::string& error);
+	void unmap();
+
+	int floatsPerVertex;
+	std::vector<SceneMesh> meshes;
+	// text scenes own their data; binary scenes point into the mapping
+	std::vector<float> ownedVertices;
+	std::vector<uint32_t> ownedIndices;
+	const float* vertices;
+	size_t vertexCount;
+	const uint32_t* indices;
+	size_t indexCount;
+	void* mapping;
+	size_t mappingSize;
+#if defined(_WIN32)
+	void* fileHandle;
+	void* mappingHandle;
+#endif
+};
+
+#endif
@@ -0,0 +1,18 @@
+#pragma once
+
+#ifndef SHAPE_GENERATOR_HPP
+#define SHAPE_GENERATOR_HPP
+
+#include <vector>
+
+// Triangle fan generators for the 6-float (position + color) vertex layout.
+namespace ShapeGenerator {
+	// Center vertex plus segments + 1 rim vertices (the last one closes the fan).
+	void appendCircle(std::vector<float>& vertices, std::vector<unsigned int>& indices,
+		float cx, float cy, float radius, int segments, float r, float g, float b);
+	// Center vertex plus one vertex per side; startAngle places the first corner.
+	void appendRegularPolygon(std::vector<float>& vertices, std::vector<unsigned int>& indices,
+		float cx, float cy, float radius, int sides, float startAngle, float r, float g, float b);
+}
+
+#endif
@@ -0,0 +1,83 @@
+// ogl
+#include <glad/glad.h>
+
+// std
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// img
+#define STB_IMAGE_IMPLEMENTATION
+#include <img/stb_image.h>
+
+// local
+#include <fixtures.hpp>
+#include <gl_stub.hpp>
+#include <import_benchmark.hpp>
+#include <micro_benchmark.hpp>
+
+int main(int argc, char** argv) {
+    // No window or context: the GL calls the fixtures make go to GlStub.
+    // --repo DIR is the checkout holding the OpenGL_* folders (default ..),
+    // --only TEXT runs the fixtures whose name contains TEXT,
+    // --samples N and --min-sample-ms MS set how each fixture is timed (default 15 and 20),
+    // --output FILE sets the result file (default micro_results.json),
+    // --import MODEL benchmarks importing an OBJ or glTF model at 1, 2, 4, ... threads up to
+    // --import-threads N (default all hardware threads) instead of running the fixtures,
+    // --import-generate MB writes a synthetic OBJ of about MB megabytes to import_benchmark.obj and imports that
+    std::string repoDirectory = "..";
+    std::string filter;
+    std::string outputPath = "micro_results.json";
+    int sampleCount = 15;
+    double minSampleMs = 20.0;
+    std::string importPath;
+    int importMegabytes = 0;
+    int importThreads = (int)std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--repo" && i + 1 < argc) {
+            repoDirectory = argv[++i];
+        } else if (arg == "--only" && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (arg == "--samples" && i + 1 < argc) {
+            sampleCount = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--min-sample-ms" && i + 1 < argc) {
+            minSampleMs = std::max(0.1, std::atof(argv[++i]));
+        } else if (arg == "--output" && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else if (arg == "--import" && i + 1 < argc) {
+            importPath = argv[++i];
+        } else if (arg == "--import-generate" && i + 1 < argc) {
+            importMegabytes = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--import-threads" && i + 1 < argc) {
+            importThreads = std::max(1, std::atoi(argv[++i]));
+        }
+    }
+
+    if (importMegabytes > 0) {
+        importPath = "import_benchmark.obj";
+        std::cout << "Writing " << importMegabytes << " MB to " << importPath << std::endl;
+        if (!ImportBenchmark::generateObj(importPath, importMegabytes)) {
+            std::cerr << "Cannot write " << importPath << std::endl;
+            return -1;
+        }
+    }
+    if (!importPath.empty()) {
+        std::vector<int> threadCounts;
+        for (int threads = 1; threads < importThreads; threads *= 2) {
+            threadCounts.push_back(threads);
+        }
+        threadCounts.push_back(importThreads);
+        return ImportBenchmark(threadCounts, 3).run(importPath) ? 0 : -1;
+    }
+
+    GlStub::install();
+
+    MicroBenchmark benchmark(minSampleMs, sampleCount);
+    Fixtures::addAll(benchmark, repoDirectory);
+    benchmark.run(filter);
+    return benchmark.writeJson(outputPath) ? 0 : -1;
+}
@@ -0,0 +1,1334 @@
+#include <mesh_importer.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+double ImportStats::getParseMegabytesPerSecond() const {
+	return parseMs <= 0.0 ? 0.0 : sourceBytes / (1024.0 * 1024.0) / (parseMs / 1000.0);
+}
+
+static double millisecondsSince(std::chrono::steady_clock::time_point start) {
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Runs function(job) for every job in [0, jobCount), handing jobs out to threadCount threads
+// (the caller being one of them) as they finish
+template <typename Function>
+static void runParallel(int threadCount, size_t jobCount, Function function) {
+	std::atomic<size_t> nextJob(0);
+	auto worker = [&]() {
+		for (size_t job = nextJob.fetch_add(1); job < jobCount; job = nextJob.fetch_add(1)) {
+			function(job);
+		}
+	};
+	std::vector<std::thread> threads;
+	for (size_t i = 1; i < std::min((size_t)threadCount, jobCount); ++i) {
+		threads.emplace_back(worker);
+	}
+	worker();
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+}
+
+// Number parsing. Floats take the exact fast path when the decimal mantissa
+// fits in 53 bits and the power of ten is exactly representable, which
+// covers what exporters write; anything else goes through strtod.
+static const double POWERS_OF_TEN[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static inline bool isDigit(char c) {
+	return c >= '0' && c <= '9';
+}
+
+static inline const char* skipBlanks(const char* cursor, const char* end) {
+	while (cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r')) {
+		++cursor;
+	}
+	return cursor;
+}
+
+// Returns the position after the number, or cursor itself if there is none
+static const char* parseFloat(const char* cursor, const char* end, float& value) {
+	const char* start = cursor;
+	bool negative = false;
+	if (cursor < end && (*cursor == '-' || *cursor == '+')) {
+		negative = *cursor == '-';
+		++cursor;
+	}
+	uint64_t mantissa = 0;
+	int digits = 0;
+	int exponent = 0;
+	bool anyDigits = false;
+	bool truncated = false;
+	for (; cursor < end && isDigit(*cursor); ++cursor) {
+		anyDigits = true;
+		if (digits < 19) {
+			mantissa = mantissa * 10 + (uint64_t)(*cursor - '0');
+			digits += mantissa != 0;
+		} else {
+			++exponent;
+			truncated = true;
+		}
+	}
+	if (cursor < end && *cursor == '.') {
+		for (++cursor; cursor < end && isDigit(*cursor); ++cursor) {
+			anyDigits = true;
+			if (digits < 19) {
+				mantissa = mantissa * 10 + (uint64_t)(*cursor - '0');
+				digits += mantissa != 0;
+				--exponent;
+			} else {
+				truncated = true;
+			}
+		}
+	}
+	if (!anyDigits) {
+		// nan, inf and friends
+		char* next = nullptr;
+		std::string text(start, std::min<size_t>(end - start, 16));
+		value = std::strtof(text.c_str(), &next);
+		return start + (next - text.c_str());
+	}
+	if (cursor < end && (*cursor == 'e' || *cursor == 'E')) {
+		const char* exponentStart = cursor++;
+		bool exponentNegative = false;
+		if (cursor < end && (*cursor == '-' || *cursor == '+')) {
+			exponentNegative = *cursor == '-';
+			++cursor;
+		}
+		if (cursor < end && isDigit(*cursor)) {
+			int explicitExponent = 0;
+			for (; cursor < end && isDigit(*cursor); ++cursor) {
+				explicitExponent = std::min(explicitExponent * 10 + (*cursor - '0'), 100000);
+			}
+			exponent += exponentNegative ? -explicitExponent : explicitExponent;
+		} else {
+			cursor = exponentStart;
+		}
+	}
+	if (!truncated && mantissa <= (1ull << 53) && exponent >= -22 && exponent <= 22) {
+		double result = (double)mantissa;
+		result = exponent < 0 ? result / POWERS_OF_TEN[-exponent] : result * POWERS_OF_TEN[exponent];
+		value = (float)(negative ? -result : result);
+		return cursor;
+	}
+	std::string text(start, cursor);
+	value = (float)std::strtod(text.c_str(), nullptr);
+	return cursor;
+}
+
+static const char* parseInteger(const char* cursor, const char* end, int64_t& value) {
+	const char* start = cursor;
+	bool negative = false;
+	if (cursor < end && (*cursor == '-' || *cursor == '+')) {
+		negative = *cursor == '-';
+		++cursor;
+	}
+	if (cursor == end || !isDigit(*cursor)) {
+		return start;
+	}
+	int64_t result = 0;
+	for (; cursor < end && isDigit(*cursor); ++cursor) {
+		result = std::min<int64_t>(result * 10 + (*cursor - '0'), INT32_MAX);
+	}
+	value = negative ? -result : result;
+	return cursor;
+}
+
+// OBJ
+
+enum ObjCornerFlags : uint32_t {
+	POSITION_RELATIVE = 1,
+	TEXCOORD_RELATIVE = 2,
+	HAS_TEXCOORD = 4
+};
+
+// One triangle corner. Relative references are resolved against the chunk's
+// own counts first and shifted by the earlier chunks' counts on merge.
+struct ObjCorner {
+	int32_t position;
+	int32_t texcoord;
+	uint32_t flags;
+};
+
+// 'o' object, 'g' group or 'u' usemtl, taking effect from corner on
+struct ObjMeshStart {
+	size_t corner;
+	char kind;
+	std::string name;
+};
+
+struct ObjChunk {
+	// position xyz, color rgb
+	std::vector<float> positions;
+	std::vector<float> texcoords;
+	std::vector<ObjCorner> corners;
+	std::vector<ObjMeshStart> meshStarts;
+	size_t lineCount;
+	size_t errorLine;
+	std::string error;
+
+	void clear() {
+		positions.clear();
+		texcoords.clear();
+		corners.clear();
+		meshStarts.clear();
+		lineCount = 0;
+		errorLine = 0;
+		error.clear();
+	}
+};
+
+static const char* parseObjReference(const char* cursor, const char* end, int32_t localCount, int32_t& index, bool& relative) {
+	int64_t value = 0;
+	const char* next = parseInteger(cursor, end, value);
+	if (next == cursor || value == 0) {
+		return cursor;
+	}
+	relative = value < 0;
+	index = (int32_t)(relative ? localCount + value : value - 1);
+	return next;
+}
+
+static void parseObjChunk(const char* cursor, const char* end, ObjChunk& chunk) {
+	chunk.clear();
+	std::vector<ObjCorner> face;
+	while (cursor < end) {
+		const char* lineEnd = (const char*)std::memchr(cursor, '\n', end - cursor);
+		if (lineEnd == nullptr) {
+			lineEnd = end;
+		}
+		++chunk.lineCount;
+		const char* p = skipBlanks(cursor, lineEnd);
+		const char* keyword = p;
+		while (p < lineEnd && *p != ' ' && *p != '\t' && *p != '\r') {
+			++p;
+		}
+		size_t keywordLength = p - keyword;
+
+		if (keywordLength == 1 && keyword[0] == 'v') {
+			float values[7];
+			int count = 0;
+			for (p = skipBlanks(p, lineEnd); count < 7; p = skipBlanks(p, lineEnd)) {
+				const char* next = parseFloat(p, lineEnd, values[count]);
+				if (next == p) {
+					break;
+				}
+				p = next;
+				++count;
+			}
+			if (count < 3) {
+				chunk.error = "vertex needs 3 coordinates";
+				chunk.errorLine = chunk.lineCount;
+				return;
+			}
+			bool hasColor = count >= 6;
+			chunk.positions.insert(chunk.positions.end(), {
+				values[0], values[1], values[2],
+				hasColor ? values[3] : 1.0f, hasColor ? values[4] : 1.0f, hasColor ? values[5] : 1.0f
+			});
+		} else if (keywordLength == 2 && keyword[0] == 'v' && keyword[1] == 't') {
+			float values[2] = { 0.0f, 0.0f };
+			p = skipBlanks(p, lineEnd);
+			const char* next = parseFloat(p, lineEnd, values[0]);
+			if (next == p) {
+				chunk.error = "texture coordinate needs a value";
+				chunk.errorLine = chunk.lineCount;
+				return;
+			}
+			parseFloat(skipBlanks(next, lineEnd), lineEnd, values[1]);
+			chunk.texcoords.insert(chunk.texcoords.end(), { values[0], values[1] });
+		} else if (keywordLength == 1 && keyword[0] == 'f') {
+			int32_t positionCount = (int32_t)(chunk.positions.size() / 6);
+			int32_t texcoordCount = (int32_t)(chunk.texcoords.size() / 2);
+			face.clear();
+			for (p = skipBlanks(p, lineEnd); p < lineEnd; p = skipBlanks(p, lineEnd)) {
+				ObjCorner corner = { 0, 0, 0 };
+				bool relative = false;
+				const char* next = parseObjReference(p, lineEnd, positionCount, corner.position, relative);
+				if (next == p) {
+					chunk.error = "bad face vertex";
+					chunk.errorLine = chunk.lineCount;
+					return;
+				}
+				corner.flags |= relative ? (uint32_t)POSITION_RELATIVE : 0u;
+				p = next;
+				if (p < lineEnd && *p == '/') {
+					++p;
+					next = parseObjReference(p, lineEnd, texcoordCount, corner.texcoord, relative);
+					if (next != p) {
+						corner.flags |= HAS_TEXCOORD | (relative ? (uint32_t)TEXCOORD_RELATIVE : 0u);
+						p = next;
+					}
+					// the normal is not used by either layout
+					if (p < lineEnd && *p == '/') {
+						int64_t normal = 0;
+						p = parseInteger(p + 1, lineEnd, normal);
+					}
+				}
+				face.push_back(corner);
+			}
+			if (face.size() < 3) {
+				chunk.error = "face needs 3 vertices";
+				chunk.errorLine = chunk.lineCount;
+				return;
+			}
+			for (size_t i = 1; i + 1 < face.size(); ++i) {
+				chunk.corners.insert(chunk.corners.end(), { face[0], face[i], face[i + 1] });
+			}
+		} else if ((keywordLength == 1 && (keyword[0] == 'o' || keyword[0] == 'g'))
+			|| (keywordLength == 6 && std::memcmp(keyword, "usemtl", 6) == 0)) {
+			p = skipBlanks(p, lineEnd);
+			const char* nameEnd = lineEnd;
+			while (nameEnd > p && (nameEnd[-1] == ' ' || nameEnd[-1] == '\t' || nameEnd[-1] == '\r')) {
+				--nameEnd;
+			}
+			chunk.meshStarts.push_back({ chunk.corners.size(), keyword[0], std::string(p, nameEnd) });
+		}
+		// vn, s, mtllib, l, p and comments are skipped
+		cursor = lineEnd + 1;
+	}
+}
+
+// A run of triangles sharing object, group and material
+struct ObjMesh {
+	std::string name;
+	int32_t material;
+	size_t firstCorner;
+	size_t cornerCount;
+};
+
+// Gives each distinct position/texcoord pair of a mesh its vertex, appending
+// new pairs to vertices. When the mesh's positions sit in a narrow range, as
+// exporters write them, vertices are chained off a dense per-position array;
+// otherwise an open addressing table is used.
+class CornerTable {
+public:
+	CornerTable(size_t cornerCount, int32_t lowestPosition, int32_t highestPosition, std::vector<uint64_t>& vertices)
+		: lowestPosition(lowestPosition), vertices(vertices) {
+		size_t span = (size_t)(highestPosition - lowestPosition) + 1;
+		dense = span <= cornerCount * 2;
+		if (dense) {
+			firstVertex.assign(span, NONE);
+			return;
+		}
+		size_t capacity = 16;
+		while (capacity < cornerCount * 2) {
+			capacity *= 2;
+		}
+		mask = capacity - 1;
+		keys.assign(capacity, EMPTY);
+		values.resize(capacity);
+	}
+
+	uint32_t findOrAdd(uint64_t key) {
+		if (dense) {
+			uint32_t& first = firstVertex[(int32_t)(key >> 32) - lowestPosition];
+			for (uint32_t vertex = first; vertex != NONE; vertex = nextVertex[vertex]) {
+				if (vertices[vertex] == key) {
+					return vertex;
+				}
+			}
+			nextVertex.push_back(first);
+			first = add(key);
+			return first;
+		}
+		size_t slot = (size_t)((key * 0x9E3779B97F4A7C15ull) >> 20) & mask;
+		while (keys[slot] != EMPTY) {
+			if (keys[slot] == key) {
+				return values[slot];
+			}
+			slot = (slot + 1) & mask;
+		}
+		keys[slot] = key;
+		values[slot] = add(key);
+		return values[slot];
+	}
+
+private:
+	uint32_t add(uint64_t key) {
+		vertices.push_back(key);
+		return (uint32_t)(vertices.size() - 1);
+	}
+
+	static constexpr uint32_t NONE = ~0u;
+	static constexpr uint64_t EMPTY = ~0ull;
+	int32_t lowestPosition;
+	std::vector<uint64_t>& vertices;
+	bool dense;
+	std::vector<uint32_t> firstVertex;
+	std::vector<uint32_t> nextVertex;
+	size_t mask = 0;
+	std::vector<uint64_t> keys;
+	std::vector<uint32_t> values;
+};
+
+bool MeshImporter::parseObj(const std::string& path, ImportedModel& model, std::string& error) {
+	std::ifstream file(path, std::ios::binary);
+	if (!file) {
+		error = "cannot open " + path;
+		return false;
+	}
+	auto parseStart = std::chrono::steady_clock::now();
+	int threadCount = getThreadCount();
+	std::vector<ObjChunk> chunks(threadCount);
+	std::vector<float> positions;
+	std::vector<float> texcoords;
+	std::vector<ObjCorner> corners;
+	std::vector<ObjMesh> meshes;
+	std::vector<std::string> materials;
+	std::string objectName, groupName, materialName;
+	size_t lineCount = 0;
+
+	auto startMesh = [&](size_t corner) {
+		if (!meshes.empty() && meshes.back().firstCorner == corner) {
+			meshes.pop_back();
+		}
+		auto material = std::find(materials.begin(), materials.end(), materialName);
+		if (material == materials.end() && !materialName.empty()) {
+			material = materials.insert(materials.end(), materialName);
+		}
+		ObjMesh mesh;
+		mesh.name = !groupName.empty() ? groupName : !objectName.empty() ? objectName : "mesh";
+		mesh.material = materialName.empty() ? 0 : (int32_t)(material - materials.begin());
+		mesh.firstCorner = corner;
+		mesh.cornerCount = 0;
+		meshes.push_back(mesh);
+	};
+	startMesh(0);
+	auto applyMeshStart = [&](const ObjMeshStart& meshStart) {
+		if (meshStart.kind == 'o') {
+			objectName = meshStart.name;
+			groupName.clear();
+		} else if (meshStart.kind == 'g') {
+			groupName = meshStart.name;
+		} else {
+			materialName = meshStart.name;
+		}
+		startMesh(corners.size());
+	};
+
+	// each round reads chunkBytes per thread after what was left of the last line
+	std::vector<char> buffer;
+	size_t carried = 0;
+	size_t readSize = options.chunkBytes * threadCount;
+	bool endOfFile = false;
+	while (!endOfFile) {
+		buffer.resize(carried + readSize);
+		file.read(buffer.data() + carried, (std::streamsize)readSize);
+		size_t filled = carried + (size_t)file.gcount();
+		endOfFile = (size_t)file.gcount() < readSize;
+		size_t usable = filled;
+		if (!endOfFile) {
+			const char* lastLine = filled == 0 ? nullptr : (const char*)std::memchr(buffer.data(), '\n', filled);
+			if (lastLine == nullptr) {
+				// a single line longer than the whole block, read on
+				carried = filled;
+				continue;
+			}
+			while (usable > 0 && buffer[usable - 1] != '\n') {
+				--usable;
+			}
+		}
+
+		const char* block = buffer.data();
+		std::vector<size_t> bounds(threadCount + 1, usable);
+		bounds[0] = 0;
+		for (int i = 1; i < threadCount; ++i) {
+			size_t bound = std::max(bounds[i - 1], usable * i / threadCount);
+			const char* lineEnd = bound >= usable ? nullptr : (const char*)std::memchr(block + bound, '\n', usable - bound);
+			bounds[i] = lineEnd == nullptr ? usable : (size_t)(lineEnd - block) + 1;
+		}
+		runParallel(threadCount, (size_t)threadCount, [&](size_t i) {
+			parseObjChunk(block + bounds[i], block + bounds[i + 1], chunks[i]);
+		});
+
+		for (ObjChunk& chunk : chunks) {
+			if (!chunk.error.empty()) {
+				error = path + ":" + std::to_string(lineCount + chunk.errorLine) + ": " + chunk.error;
+				return false;
+			}
+			size_t cornerBase = corners.size();
+			int32_t positionBase = (int32_t)(positions.size() / 6);
+			int32_t texcoordBase = (int32_t)(texcoords.size() / 2);
+			size_t nextStart = 0;
+			for (ObjCorner corner : chunk.corners) {
+				while (nextStart < chunk.meshStarts.size() && chunk.meshStarts[nextStart].corner == corners.size() - cornerBase) {
+					applyMeshStart(chunk.meshStarts[nextStart++]);
+				}
+				corner.position += (corner.flags & POSITION_RELATIVE) ? positionBase : 0;
+				corner.texcoord += (corner.flags & TEXCOORD_RELATIVE) ? texcoordBase : 0;
+				corners.push_back(corner);
+			}
+			for (; nextStart < chunk.meshStarts.size(); ++nextStart) {
+				applyMeshStart(chunk.meshStarts[nextStart]);
+			}
+			positions.insert(positions.end(), chunk.positions.begin(), chunk.positions.end());
+			texcoords.insert(texcoords.end(), chunk.texcoords.begin(), chunk.texcoords.end());
+			lineCount += chunk.lineCount;
+		}
+
+		carried = filled - usable;
+		std::memmove(buffer.data(), buffer.data() + usable, carried);
+	}
+	chunks.clear();
+	std::vector<char>().swap(buffer);
+	if (!meshes.empty() && meshes.back().firstCorner == corners.size()) {
+		meshes.pop_back();
+	}
+	for (size_t i = 0; i < meshes.size(); ++i) {
+		meshes[i].cornerCount = (i + 1 < meshes.size() ? meshes[i + 1].firstCorner : corners.size()) - meshes[i].firstCorner;
+	}
+	stats.parseMs = millisecondsSince(parseStart);
+
+	// every mesh gets its own vertices: one per distinct position/texcoord pair it uses
+	auto buildStart = std::chrono::steady_clock::now();
+	int32_t positionCount = (int32_t)(positions.size() / 6);
+	int32_t texcoordCount = (int32_t)(texcoords.size() / 2);
+	std::vector<std::vector<uint64_t>> meshVertices(meshes.size());
+	std::vector<std::string> meshErrors(meshes.size());
+	model.indices.resize(corners.size());
+	runParallel(threadCount, meshes.size(), [&](size_t m) {
+		const ObjMesh& mesh = meshes[m];
+		int32_t lowestPosition = INT32_MAX, highestPosition = 0;
+		for (size_t i = mesh.firstCorner; i < mesh.firstCorner + mesh.cornerCount; ++i) {
+			const ObjCorner& corner = corners[i];
+			if (corner.position < 0 || corner.position >= positionCount || ((corner.flags & HAS_TEXCOORD)
+				&& (corner.texcoord < 0 || corner.texcoord >= texcoordCount))) {
+				meshErrors[m] = path + ": mesh " + mesh.name + " references a missing vertex";
+				return;
+			}
+			lowestPosition = std::min(lowestPosition, corner.position);
+			highestPosition = std::max(highestPosition, corner.position);
+		}
+		CornerTable table(mesh.cornerCount, lowestPosition, highestPosition, meshVertices[m]);
+		for (size_t i = mesh.firstCorner; i < mesh.firstCorner + mesh.cornerCount; ++i) {
+			const ObjCorner& corner = corners[i];
+			uint32_t texcoord = (corner.flags & HAS_TEXCOORD) ? (uint32_t)corner.texcoord + 1 : 0;
+			model.indices[i] = table.findOrAdd(((uint64_t)(uint32_t)corner.position << 32) | texcoord);
+		}
+	});
+	for (const std::string& meshError : meshErrors) {
+		if (!meshError.empty()) {
+			error = meshError;
+			return false;
+		}
+	}
+	std::vector<ObjCorner>().swap(corners);
+
+	int floatsPerVertex = options.floatsPerVertex;
+	size_t vertexCount = 0;
+	for (size_t m = 0; m < meshes.size(); ++m) {
+		SceneMesh mesh;
+		mesh.name = meshes[m].name;
+		mesh.material = meshes[m].material;
+		mesh.baseVertex = (uint32_t)vertexCount;
+		mesh.vertexCount = (uint32_t)meshVertices[m].size();
+		mesh.firstIndex = (uint32_t)meshes[m].firstCorner;
+		mesh.indexCount = (uint32_t)meshes[m].cornerCount;
+		model.meshes.push_back(mesh);
+		vertexCount += meshVertices[m].size();
+	}
+	model.floatsPerVertex = floatsPerVertex;
+	model.vertices.resize(vertexCount * floatsPerVertex);
+	runParallel(threadCount, meshes.size(), [&](size_t m) {
+		float* vertex = model.vertices.data() + (size_t)model.meshes[m].baseVertex * floatsPerVertex;
+		for (uint64_t key : meshVertices[m]) {
+			const float* position = positions.data() + (key >> 32) * 6;
+			uint32_t texcoord = (uint32_t)key;
+			vertex = std::copy(position, position + 6, vertex);
+			if (floatsPerVertex == 9) {
+				*vertex++ = 1.0f;
+				*vertex++ = texcoord == 0 ? 0.0f : texcoords[(texcoord - 1) * 2];
+				*vertex++ = texcoord == 0 ? 0.0f : texcoords[(texcoord - 1) * 2 + 1];
+			}
+		}
+	});
+	stats.buildMs = millisecondsSince(buildStart);
+	return true;
+}
+
+// glTF
+
+// Just enough JSON for a glTF document
+struct JsonValue {
+	enum Type { Null, Boolean, Number, String, Array, Object };
+
+	Type type = Null;
+	bool boolean = false;
+	double number = 0.0;
+	std::string string;
+	std::vector<JsonValue> items;
+	std::vector<std::pair<std::string, JsonValue>> members;
+
+	const JsonValue& operator[](const char* key) const {
+		for (const auto& member : members) {
+			if (member.first == key) {
+				return member.second;
+			}
+		}
+		return getNull();
+	}
+
+	const JsonValue& operator[](size_t index) const {
+		return index < items.size() ? items[index] : getNull();
+	}
+
+	const JsonValue& operator[](int index) const {
+		return index < 0 ? getNull() : (*this)[(size_t)index];
+	}
+
+	bool has(const char* key) const {
+		return (*this)[key].type != Null;
+	}
+
+	double getNumber(double fallback) const {
+		return type == Number ? number : fallback;
+	}
+
+	int getInt(int fallback) const {
+		return type == Number ? (int)number : fallback;
+	}
+
+	static const JsonValue& getNull() {
+		static const JsonValue null;
+		return null;
+	}
+};
+
+class JsonParser {
+public:
+	JsonParser(const char* text, size_t length) : cursor(text), end(text + length), length(length) {}
+
+	bool parse(JsonValue& value, std::string& error) {
+		if (!parseValue(value, 0) || (skipWhitespace(), cursor != end)) {
+			error = "invalid JSON near byte " + std::to_string(length - (end - cursor));
+			return false;
+		}
+		return true;
+	}
+
+private:
+	void skipWhitespace() {
+		while (cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\n' || *cursor == '\r')) {
+			++cursor;
+		}
+	}
+
+	bool literal(const char* word) {
+		size_t size = std::strlen(word);
+		if ((size_t)(end - cursor) < size || std::memcmp(cursor, word, size) != 0) {
+			return false;
+		}
+		cursor += size;
+		return true;
+	}
+
+	bool parseString(std::string& out) {
+		if (cursor == end || *cursor != '"') {
+			return false;
+		}
+		for (++cursor; cursor < end && *cursor != '"'; ++cursor) {
+			if (*cursor != '\\') {
+				out += *cursor;
+				continue;
+			}
+			if (++cursor == end) {
+				return false;
+			}
+			switch (*cursor) {
+			case 'b': out += '\b'; break;
+			case 'f': out += '\f'; break;
+			case 'n': out += '\n'; break;
+			case 'r': out += '\r'; break;
+			case 't': out += '\t'; break;
+			case 'u': {
+				if (end - cursor < 5) {
+					return false;
+				}
+				unsigned int code = (unsigned int)std::strtoul(std::string(cursor + 1, cursor + 5).c_str(), nullptr, 16);
+				cursor += 4;
+				if (code < 0x80) {
+					out += (char)code;
+				} else if (code < 0x800) {
+					out += (char)(0xC0 | (code >> 6));
+					out += (char)(0x80 | (code & 0x3F));
+				} else {
+					out += (char)(0xE0 | (code >> 12));
+					out += (char)(0x80 | ((code >> 6) & 0x3F));
+					out += (char)(0x80 | (code & 0x3F));
+				}
+				break;
+			}
+			default: out += *cursor; break;
+			}
+		}
+		if (cursor == end) {
+			return false;
+		}
+		++cursor;
+		return true;
+	}
+
+	bool parseValue(JsonValue& value, int depth) {
+		skipWhitespace();
+		if (cursor == end || depth > 64) {
+			return false;
+		}
+		if (*cursor == '{') {
+			value.type = JsonValue::Object;
+			++cursor;
+			skipWhitespace();
+			if (cursor < end && *cursor == '}') {
+				++cursor;
+				return true;
+			}
+			while (true) {
+				skipWhitespace();
+				value.members.emplace_back();
+				if (!parseString(value.members.back().first)) {
+					return false;
+				}
+				skipWhitespace();
+				if (cursor == end || *cursor++ != ':' || !parseValue(value.members.back().second, depth + 1)) {
+					return false;
+				}
+				skipWhitespace();
+				if (cursor < end && *cursor == ',') {
+					++cursor;
+				} else {
+					return cursor < end && *cursor++ == '}';
+				}
+			}
+		}
+		if (*cursor == '[') {
+			value.type = JsonValue::Array;
+			++cursor;
+			skipWhitespace();
+			if (cursor < end && *cursor == ']') {
+				++cursor;
+				return true;
+			}
+			while (true) {
+				value.items.emplace_back();
+				if (!parseValue(value.items.back(), depth + 1)) {
+					return false;
+				}
+				skipWhitespace();
+				if (cursor < end && *cursor == ',') {
+					++cursor;
+				} else {
+					return cursor < end && *cursor++ == ']';
+				}
+			}
+		}
+		if (*cursor == '"') {
+			value.type = JsonValue::String;
+			return parseString(value.string);
+		}
+		if (literal("true")) {
+			value.type = JsonValue::Boolean;
+			value.boolean = true;
+			return true;
+		}
+		if (literal("false")) {
+			value.type = JsonValue::Boolean;
+			return true;
+		}
+		if (literal("null")) {
+			return true;
+		}
+		float ignored;
+		const char* numberStart = cursor;
+		const char* next = parseFloat(cursor, end, ignored);
+		if (next == cursor) {
+			return false;
+		}
+		// document values such as byte offsets need the full double
+		value.type = JsonValue::Number;
+		value.number = std::strtod(std::string(numberStart, next).c_str(), nullptr);
+		cursor = next;
+		return true;
+	}
+
+	const char* cursor;
+	const char* end;
+	size_t length;
+};
+
+static bool readWholeFile(const std::string& path, std::vector<unsigned char>& data) {
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if (!file) {
+		return false;
+	}
+	data.resize((size_t)file.tellg());
+	file.seekg(0);
+	file.read((char*)data.data(), (std::streamsize)data.size());
+	return (bool)file;
+}
+
+static bool decodeBase64(const std::string& text, size_t start, std::vector<unsigned char>& data) {
+	unsigned int accumulator = 0;
+	int bits = 0;
+	for (size_t i = start; i < text.size() && text[i] != '='; ++i) {
+		char c = text[i];
+		int digit = c >= 'A' && c <= 'Z' ? c - 'A' : c >= 'a' && c <= 'z' ? c - 'a' + 26
+			: c >= '0' && c <= '9' ? c - '0' + 52 : c == '+' ? 62 : c == '/' ? 63 : -1;
+		if (digit < 0) {
+			return false;
+		}
+		accumulator = (accumulator << 6) | (unsigned int)digit;
+		bits += 6;
+		if (bits >= 8) {
+			bits -= 8;
+			data.push_back((unsigned char)(accumulator >> bits));
+		}
+	}
+	return true;
+}
+
+// Column-major, as glTF stores it
+struct NodeMatrix {
+	float m[16];
+
+	static NodeMatrix identity() {
+		NodeMatrix matrix = {};
+		matrix.m[0] = matrix.m[5] = matrix.m[10] = matrix.m[15] = 1.0f;
+		return matrix;
+	}
+
+	NodeMatrix operator*(const NodeMatrix& other) const {
+		NodeMatrix result = {};
+		for (int column = 0; column < 4; ++column) {
+			for (int row = 0; row < 4; ++row) {
+				for (int k = 0; k < 4; ++k) {
+					result.m[column * 4 + row] += m[k * 4 + row] * other.m[column * 4 + k];
+				}
+			}
+		}
+		return result;
+	}
+
+	static NodeMatrix fromNode(const JsonValue& node) {
+		NodeMatrix matrix = identity();
+		const JsonValue& values = node["matrix"];
+		if (values.items.size() == 16) {
+			for (int i = 0; i < 16; ++i) {
+				matrix.m[i] = (float)values[i].getNumber(0.0);
+			}
+			return matrix;
+		}
+		const JsonValue& t = node["translation"];
+		const JsonValue& r = node["rotation"];
+		const JsonValue& s = node["scale"];
+		float x = (float)r[0].getNumber(0.0), y = (float)r[1].getNumber(0.0), z = (float)r[2].getNumber(0.0), w = (float)r[3].getNumber(1.0);
+		float sx = (float)s[0].getNumber(1.0), sy = (float)s[1].getNumber(1.0), sz = (float)s[2].getNumber(1.0);
+		// T * R * S
+		matrix.m[0] = (1 - 2 * (y * y + z * z)) * sx;
+		matrix.m[1] = (2 * (x * y + z * w)) * sx;
+		matrix.m[2] = (2 * (x * z - y * w)) * sx;
+		matrix.m[4] = (2 * (x * y - z * w)) * sy;
+		matrix.m[5] = (1 - 2 * (x * x + z * z)) * sy;
+		matrix.m[6] = (2 * (y * z + x * w)) * sy;
+		matrix.m[8] = (2 * (x * z + y * w)) * sz;
+		matrix.m[9] = (2 * (y * z - x * w)) * sz;
+		matrix.m[10] = (1 - 2 * (x * x + y * y)) * sz;
+		matrix.m[12] = (float)t[0].getNumber(0.0);
+		matrix.m[13] = (float)t[1].getNumber(0.0);
+		matrix.m[14] = (float)t[2].getNumber(0.0);
+		return matrix;
+	}
+};
+
+struct GltfDocument {
+	JsonValue json;
+	std::vector<std::vector<unsigned char>> buffers;
+
+	// Reads accessor as componentCount floats per element; fewer stored components are
+	// padded with fill. normalized integers map to [0, 1] or [-1, 1]
+	bool readFloats(int accessorIndex, int componentCount, float fill, std::vector<float>& out, std::string& error) const {
+		const unsigned char* data;
+		size_t count, stride;
+		int componentType, storedComponents;
+		if (!locate(accessorIndex, data, count, stride, componentType, storedComponents, error)) {
+			return false;
+		}
+		bool normalized = json["accessors"][(size_t)accessorIndex]["normalized"].boolean;
+		out.assign(count * componentCount, fill);
+		if (data == nullptr) {
+			return true;
+		}
+		for (size_t i = 0; i < count; ++i) {
+			const unsigned char* element = data + i * stride;
+			for (int c = 0; c < std::min(componentCount, storedComponents); ++c) {
+				float value;
+				float range = 0.0f;
+				switch (componentType) {
+				case 5120: value = (float)((const int8_t*)element)[c]; range = 127.0f; break;
+				case 5121: value = (float)element[c]; range = 255.0f; break;
+				case 5122: { int16_t v; std::memcpy(&v, element + c * 2, 2); value = (float)v; range = 32767.0f; break; }
+				case 5123: { uint16_t v; std::memcpy(&v, element + c * 2, 2); value = (float)v; range = 65535.0f; break; }
+				case 5125: { uint32_t v; std::memcpy(&v, element + c * 4, 4); value = (float)v; break; }
+				default: std::memcpy(&value, element + c * 4, 4); break;
+				}
+				out[i * componentCount + c] = normalized && range > 0.0f ? std::max(value / range, -1.0f) : value;
+			}
+		}
+		return true;
+	}
+
+	bool readIndices(int accessorIndex, std::vector<uint32_t>& out, std::string& error) const {
+		const unsigned char* data;
+		size_t count, stride;
+		int componentType, storedComponents;
+		if (!locate(accessorIndex, data, count, stride, componentType, storedComponents, error)) {
+			return false;
+		}
+		if (componentType != 5121 && componentType != 5123 && componentType != 5125) {
+			error = "indices must be unsigned integers";
+			return false;
+		}
+		out.assign(count, 0);
+		if (data == nullptr) {
+			return true;
+		}
+		for (size_t i = 0; i < count; ++i) {
+			const unsigned char* element = data + i * stride;
+			if (componentType == 5121) {
+				out[i] = *element;
+			} else if (componentType == 5123) {
+				uint16_t value;
+				std::memcpy(&value, element, 2);
+				out[i] = value;
+			} else {
+				std::memcpy(&out[i], element, 4);
+			}
+		}
+		return true;
+	}
+
+private:
+	bool locate(int accessorIndex, const unsigned char*& data, size_t& count, size_t& stride, int& componentType,
+		int& componentCount, std::string& error) const {
+		const JsonValue& accessor = json["accessors"][(size_t)accessorIndex];
+		if (accessor.type != JsonValue::Object) {
+			error = "missing accessor " + std::to_string(accessorIndex);
+			return false;
+		}
+		if (accessor.has("sparse")) {
+			error = "sparse accessors are not supported";
+			return false;
+		}
+		const std::string& type = accessor["type"].string;
+		componentCount = type == "SCALAR" ? 1 : type == "VEC2" ? 2 : type == "VEC3" ? 3 : type == "VEC4" ? 4 : 0;
+		componentType = accessor["componentType"].getInt(0);
+		int componentSize = componentType == 5120 || componentType == 5121 ? 1 : componentType == 5122 || componentType == 5123 ? 2
+			: componentType == 5125 || componentType == 5126 ? 4 : 0;
+		count = (size_t)accessor["count"].getNumber(0.0);
+		if (componentCount == 0 || componentSize == 0) {
+			error = "accessor " + std::to_string(accessorIndex) + " has an unsupported type";
+			return false;
+		}
+		data = nullptr;
+		stride = (size_t)(componentCount * componentSize);
+		if (!accessor.has("bufferView")) {
+			// all zeros
+			return true;
+		}
+		const JsonValue& view = json["bufferViews"][(size_t)accessor["bufferView"].getInt(-1)];
+		size_t bufferIndex = (size_t)view["buffer"].getInt(-1);
+		size_t viewOffset = (size_t)view["byteOffset"].getNumber(0.0);
+		size_t viewLength = (size_t)view["byteLength"].getNumber(0.0);
+		size_t offset = (size_t)accessor["byteOffset"].getNumber(0.0);
+		size_t elementSize = stride;
+		stride = std::max(stride, (size_t)view["byteStride"].getNumber(0.0));
+		if (bufferIndex >= buffers.size() || viewOffset + viewLength > buffers[bufferIndex].size()
+			|| (count > 0 && offset + (count - 1) * stride + elementSize > viewLength)) {
+			error = "accessor " + std::to_string(accessorIndex) + " runs past its buffer";
+			return false;
+		}
+		data = buffers[bufferIndex].data() + viewOffset + offset;
+		return true;
+	}
+};
+
+bool MeshImporter::parseGltf(const std::string& path, ImportedModel& model, std::string& error) {
+	auto parseStart = std::chrono::steady_clock::now();
+	std::vector<unsigned char> file;
+	if (!readWholeFile(path, file)) {
+		error = "cannot open " + path;
+		return false;
+	}
+	GltfDocument document;
+	const char* jsonText = (const char*)file.data();
+	size_t jsonLength = file.size();
+	std::vector<unsigned char> binaryChunk;
+	uint32_t header[5] = {};
+	std::memcpy(header, file.data(), std::min(file.size(), sizeof(header)));
+	if (file.size() >= 20 && std::memcmp(file.data(), "glTF", 4) == 0) {
+		// .glb: 12 byte header, then the JSON chunk and an optional BIN chunk
+		size_t jsonChunkLength = header[3];
+		if (header[1] != 2 || header[4] != 0x4E4F534A || 20 + jsonChunkLength > file.size()) {
+			error = path + ": not a version 2 binary glTF";
+			return false;
+		}
+		jsonText = (const char*)file.data() + 20;
+		jsonLength = jsonChunkLength;
+		size_t binaryStart = 20 + ((jsonChunkLength + 3) & ~(size_t)3);
+		if (binaryStart + 8 <= file.size()) {
+			uint32_t binaryHeader[2];
+			std::memcpy(binaryHeader, file.data() + binaryStart, 8);
+			if (binaryHeader[1] == 0x004E4942 && binaryStart + 8 + binaryHeader[0] <= file.size()) {
+				binaryChunk.assign(file.begin() + binaryStart + 8, file.begin() + binaryStart + 8 + binaryHeader[0]);
+			}
+		}
+	}
+	JsonParser parser(jsonText, jsonLength);
+	if (!parser.parse(document.json, error)) {
+		error = path + ": " + error;
+		return false;
+	}
+	std::vector<unsigned char>().swap(file);
+
+	std::filesystem::path directory = std::filesystem::path(path).parent_path();
+	const JsonValue& buffers = document.json["buffers"];
+	for (size_t i = 0; i < buffers.items.size(); ++i) {
+		const JsonValue& uri = buffers[i]["uri"];
+		document.buffers.emplace_back();
+		std::vector<unsigned char>& data = document.buffers.back();
+		if (uri.type != JsonValue::String) {
+			data.swap(binaryChunk);
+		} else if (uri.string.compare(0, 5, "data:") == 0) {
+			size_t comma = uri.string.find(";base64,");
+			if (comma == std::string::npos || !decodeBase64(uri.string, comma + 8, data)) {
+				error = path + ": buffer " + std::to_string(i) + " is not a base64 data URI";
+				return false;
+			}
+		} else if (!readWholeFile((directory / uri.string).string(), data)) {
+			error = path + ": cannot read buffer " + uri.string;
+			return false;
+		}
+	}
+	stats.parseMs = millisecondsSince(parseStart);
+
+	// mesh instances from the scene's node tree; without nodes every mesh is placed as is
+	auto buildStart = std::chrono::steady_clock::now();
+	const JsonValue& nodes = document.json["nodes"];
+	const JsonValue& gltfMeshes = document.json["meshes"];
+	std::vector<std::pair<int, NodeMatrix>> instances;
+	std::vector<std::pair<int, NodeMatrix>> stack;
+	const JsonValue& scene = document.json["scenes"][(size_t)document.json["scene"].getInt(0)];
+	if (scene.has("nodes")) {
+		for (const JsonValue& root : scene["nodes"].items) {
+			stack.emplace_back(root.getInt(-1), NodeMatrix::identity());
+		}
+	} else if (!nodes.items.empty()) {
+		std::vector<bool> isChild(nodes.items.size(), false);
+		for (const JsonValue& node : nodes.items) {
+			for (const JsonValue& child : node["children"].items) {
+				if ((size_t)child.getInt(-1) < isChild.size()) {
+					isChild[child.getInt(-1)] = true;
+				}
+			}
+		}
+		for (size_t i = 0; i < nodes.items.size(); ++i) {
+			if (!isChild[i]) {
+				stack.emplace_back((int)i, NodeMatrix::identity());
+			}
+		}
+	} else {
+		for (size_t i = 0; i < gltfMeshes.items.size(); ++i) {
+			instances.emplace_back((int)i, NodeMatrix::identity());
+		}
+	}
+	// a malformed tree with cycles stops after visiting this many nodes
+	size_t visitsLeft = nodes.items.size() * 4 + 16;
+	while (!stack.empty() && visitsLeft-- > 0) {
+		auto entry = stack.back();
+		stack.pop_back();
+		const JsonValue& node = nodes[(size_t)entry.first];
+		NodeMatrix world = entry.second * NodeMatrix::fromNode(node);
+		if (node.has("mesh")) {
+			instances.emplace_back(node["mesh"].getInt(-1), world);
+		}
+		for (const JsonValue& child : node["children"].items) {
+			stack.emplace_back(child.getInt(-1), world);
+		}
+	}
+
+	struct PrimitiveJob {
+		const JsonValue* primitive;
+		std::string name;
+		NodeMatrix transform;
+		std::vector<float> vertices;
+		std::vector<uint32_t> indices;
+		std::string error;
+	};
+	std::vector<PrimitiveJob> jobs;
+	for (const auto& instance : instances) {
+		const JsonValue& mesh = gltfMeshes[(size_t)instance.first];
+		const JsonValue& primitives = mesh["primitives"];
+		for (size_t p = 0; p < primitives.items.size(); ++p) {
+			if (primitives[p]["mode"].getInt(4) != 4) {
+				continue;
+			}
+			PrimitiveJob job;
+			job.primitive = &primitives[p];
+			job.name = mesh.has("name") ? mesh["name"].string : "mesh" + std::to_string(instance.first);
+			if (primitives.items.size() > 1) {
+				job.name += "_" + std::to_string(p);
+			}
+			job.transform = instance.second;
+			jobs.push_back(std::move(job));
+		}
+	}
+
+	int floatsPerVertex = options.floatsPerVertex;
+	runParallel(getThreadCount(), jobs.size(), [&](size_t j) {
+		PrimitiveJob& job = jobs[j];
+		const JsonValue& attributes = (*job.primitive)["attributes"];
+		if (!attributes.has("POSITION")) {
+			job.error = job.name + " has no positions";
+			return;
+		}
+		std::vector<float> positions, colors, texcoords;
+		if (!document.readFloats(attributes["POSITION"].getInt(-1), 3, 0.0f, positions, job.error)
+			|| (attributes.has("COLOR_0") && !document.readFloats(attributes["COLOR_0"].getInt(-1), 4, 1.0f, colors, job.error))
+			|| (attributes.has("TEXCOORD_0") && !document.readFloats(attributes["TEXCOORD_0"].getInt(-1), 2, 0.0f, texcoords, job.error))) {
+			return;
+		}
+		size_t vertexCount = positions.size() / 3;
+		if (job.primitive->has("indices")) {
+			if (!document.readIndices((*job.primitive)["indices"].getInt(-1), job.indices, job.error)) {
+				return;
+			}
+			for (uint32_t index : job.indices) {
+				if (index >= vertexCount) {
+					job.error = job.name + " indexes past its vertices";
+					return;
+				}
+			}
+		} else {
+			job.indices.resize(vertexCount);
+			for (size_t i = 0; i < vertexCount; ++i) {
+				job.indices[i] = (uint32_t)i;
+			}
+		}
+		job.indices.resize(job.indices.size() / 3 * 3);
+
+		// vertex colors times the material's base color
+		float baseColor[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+		const JsonValue& factor = document.json["materials"][(size_t)(*job.primitive)["material"].getInt(-1)]["pbrMetallicRoughness"]["baseColorFactor"];
+		for (int c = 0; c < 4; ++c) {
+			baseColor[c] = (float)factor[c].getNumber(1.0);
+		}
+		const float* m = job.transform.m;
+		job.vertices.resize(vertexCount * floatsPerVertex);
+		float* vertex = job.vertices.data();
+		for (size_t i = 0; i < vertexCount; ++i) {
+			float x = positions[i * 3], y = positions[i * 3 + 1], z = positions[i * 3 + 2];
+			*vertex++ = m[0] * x + m[4] * y + m[8] * z + m[12];
+			*vertex++ = m[1] * x + m[5] * y + m[9] * z + m[13];
+			*vertex++ = m[2] * x + m[6] * y + m[10] * z + m[14];
+			for (int c = 0; c < (floatsPerVertex == 9 ? 4 : 3); ++c) {
+				*vertex++ = (colors.empty() ? 1.0f : colors[i * 4 + c]) * baseColor[c];
+			}
+			if (floatsPerVertex == 9) {
+				// glTF puts the texture origin at the top left, the demos at the bottom left
+				*vertex++ = texcoords.empty() ? 0.0f : texcoords[i * 2];
+				*vertex++ = texcoords.empty() ? 0.0f : 1.0f - texcoords[i * 2 + 1];
+			}
+		}
+	});
+
+	model.floatsPerVertex = floatsPerVertex;
+	for (PrimitiveJob& job : jobs) {
+		if (!job.error.empty()) {
+			error = path + ": " + job.error;
+			return false;
+		}
+		SceneMesh mesh;
+		mesh.name = job.name;
+		mesh.material = (int32_t)std::max(0, (*job.primitive)["material"].getInt(0));
+		mesh.baseVertex = (uint32_t)(model.vertices.size() / floatsPerVertex);
+		mesh.vertexCount = (uint32_t)(job.vertices.size() / floatsPerVertex);
+		mesh.firstIndex = (uint32_t)model.indices.size();
+		mesh.indexCount = (uint32_t)job.indices.size();
+		model.meshes.push_back(mesh);
+		model.vertices.insert(model.vertices.end(), job.vertices.begin(), job.vertices.end());
+		model.indices.insert(model.indices.end(), job.indices.begin(), job.indices.end());
+		std::vector<float>().swap(job.vertices);
+		std::vector<uint32_t>().swap(job.indices);
+	}
+	stats.buildMs = millisecondsSince(buildStart);
+	return true;
+}
+
+// MeshImporter
+
+MeshImporter::MeshImporter(const ImportOptions& options) : options(options), stats() {
+	if (this->options.floatsPerVertex != 6) {
+		this->options.floatsPerVertex = 9;
+	}
+	this->options.chunkBytes = std::max<size_t>(this->options.chunkBytes, 4096);
+}
+
+int MeshImporter::getThreadCount() const {
+	return options.threadCount > 0 ? options.threadCount : (int)std::max(1u, std::thread::hardware_concurrency());
+}
+
+const ImportStats& MeshImporter::getStats() const {
+	return stats;
+}
+
+std::string MeshImporter::getCachePath(const std::string& path) const {
+	std::error_code errorCode;
+	std::filesystem::path source = std::filesystem::absolute(path, errorCode);
+	uintmax_t size = std::filesystem::file_size(source, errorCode);
+	if (errorCode) {
+		return "";
+	}
+	auto modified = std::filesystem::last_write_time(source, errorCode).time_since_epoch().count();
+	// FNV-1a over everything that changes the output
+	std::string key = source.string() + "|" + std::to_string(size) + "|" + std::to_string((long long)modified) + "|"
+		+ std::to_string(CACHE_VERSION) + "|" + std::to_string(options.floatsPerVertex) + "|" + (options.fitToView ? "fit" : "raw");
+	uint64_t hash = 0xcbf29ce484222325ull;
+	for (char c : key) {
+		hash = (hash ^ (unsigned char)c) * 0x100000001b3ull;
+	}
+	char hex[17];
+	std::snprintf(hex, sizeof(hex), "%016llx", (unsigned long long)hash);
+	std::filesystem::path directory = options.cacheDirectory.empty() ? source.parent_path() : std::filesystem::path(options.cacheDirectory);
+	return (directory / (source.stem().string() + "." + hex + ".sceneb")).string();
+}
+
+bool MeshImporter::parse(const std::string& path, ImportedModel& model, std::string& error) {
+	stats = ImportStats();
+	stats.threadCount = getThreadCount();
+	model = ImportedModel();
+	std::error_code errorCode;
+	stats.sourceBytes = (size_t)std::filesystem::file_size(path, errorCode);
+	if (errorCode) {
+		error = "cannot open " + path;
+		return false;
+	}
+
+	std::string extension = std::filesystem::path(path).extension().string();
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return (char)std::tolower((unsigned char)c); });
+	bool parsed;
+	if (extension == ".obj") {
+		parsed = parseObj(path, model, error);
+	} else if (extension == ".gltf" || extension == ".glb") {
+		parsed = parseGltf(path, model, error);
+	} else {
+		error = path + ": unsupported model format, expected .obj, .gltf or .glb";
+		return false;
+	}
+	if (!parsed) {
+		return false;
+	}
+	if (options.fitToView) {
+		auto fitStart = std::chrono::steady_clock::now();
+		fitToView(model);
+		stats.buildMs += millisecondsSince(fitStart);
+	}
+	stats.meshCount = model.meshes.size();
+	stats.vertexCount = model.vertices.size() / model.floatsPerVertex;
+	stats.indexCount = model.indices.size();
+	return true;
+}
+
+void MeshImporter::fitToView(ImportedModel& model) const {
+	size_t vertexCount = model.vertices.size() / model.floatsPerVertex;
+	if (vertexCount == 0) {
+		return;
+	}
+	float minimum[3] = { INFINITY, INFINITY, INFINITY };
+	float maximum[3] = { -INFINITY, -INFINITY, -INFINITY };
+	for (size_t i = 0; i < vertexCount; ++i) {
+		const float* position = model.vertices.data() + i * model.floatsPerVertex;
+		for (int a = 0; a < 3; ++a) {
+			minimum[a] = std::min(minimum[a], position[a]);
+			maximum[a] = std::max(maximum[a], position[a]);
+		}
+	}
+	// one scale for all axes so the model keeps its proportions
+	float scale = INFINITY;
+	const float halfExtent[3] = { 0.9f, 0.9f, 0.5f };
+	for (int a = 0; a < 3; ++a) {
+		if (maximum[a] > minimum[a]) {
+			scale = std::min(scale, 2.0f * halfExtent[a] / (maximum[a] - minimum[a]));
+		}
+	}
+	if (scale == INFINITY) {
+		scale = 1.0f;
+	}
+	for (size_t i = 0; i < vertexCount; ++i) {
+		float* position = model.vertices.data() + i * model.floatsPerVertex;
+		for (int a = 0; a < 3; ++a) {
+			position[a] = (position[a] - (minimum[a] + maximum[a]) * 0.5f) * scale;
+		}
+		// models look down -z, NDC depth grows away from the viewer
+		position[2] = -position[2];
+	}
+}
+
+bool MeshImporter::import(const std::string& path, SceneFile& scene, std::string& error) {
+	std::string cachePath = getCachePath(path);
+	if (cachePath.empty()) {
+		error = "cannot open " + path;
+		return false;
+	}
+	auto loadStart = std::chrono::steady_clock::now();
+	std::string cacheError;
+	if (std::filesystem::exists(cachePath) && scene.load(cachePath, cacheError) && scene.getFloatsPerVertex() == options.floatsPerVertex) {
+		stats = ImportStats();
+		stats.cacheHit = true;
+		stats.loadMs = millisecondsSince(loadStart);
+		stats.meshCount = scene.getMeshes().size();
+		stats.vertexCount = scene.getVertexCount();
+		stats.indexCount = scene.getIndexCount();
+		return true;
+	}
+
+	// a missing, damaged or mismatched cache is rebuilt
+	ImportedModel model;
+	if (!parse(path, model, error)) {
+		return false;
+	}
+	auto writeStart = std::chrono::steady_clock::now();
+	std::error_code errorCode;
+	std::filesystem::create_directories(std::filesystem::path(cachePath).parent_path(), errorCode);
+	// written under a temporary name so an interrupted import never leaves a truncated cache behind
+	std::string temporaryPath = cachePath + ".tmp";
+	if (!SceneFile::write(temporaryPath, model.floatsPerVertex, model.meshes, model.vertices.data(), stats.vertexCount,
+		model.indices.data(), model.indices.size(), error)) {
+		return false;
+	}
+	std::filesystem::rename(temporaryPath, cachePath, errorCode);
+	if (errorCode) {
+		error = "cannot write " + cachePath;
+		return false;
+	}
+	stats.writeMs = millisecondsSince(writeStart);
+	model = ImportedModel();
+
+	loadStart = std::chrono::steady_clock::now();
+	if (!scene.load(cachePath, error)) {
+		return false;
+	}
+	stats.loadMs = millisecondsSince(loadStart);
+	return true;
+}
@@ -0,0 +1,119 @@
+#include <micro_benchmark.hpp>
+#include <allocation_counter.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+static volatile const void* pointerSink = nullptr;
+static volatile double valueSink = 0.0;
+
+MicroBenchmark::MicroBenchmark(double minSampleMs, int sampleCount)
+	: minSampleMs(minSampleMs), sampleCount(std::max(1, sampleCount)) {}
+
+void MicroBenchmark::keep(const void* pointer) {
+	pointerSink = pointer;
+}
+
+void MicroBenchmark::keep(double value) {
+	valueSink = value;
+}
+
+void MicroBenchmark::add(const std::string& name, const std::function<void()>& body) {
+	fixtures.push_back({ name, body });
+}
+
+static double runBatch(const std::function<void()>& body, size_t iterations) {
+	auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < iterations; ++i) {
+		body();
+	}
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+MicroResult MicroBenchmark::measure(const std::string& name, const std::function<void()>& body) const {
+	// one untimed call for first-touch costs (file cache, lazy statics)
+	body();
+	size_t iterations = 1;
+	while (runBatch(body, iterations) < minSampleMs && iterations < (size_t(1) << 30)) {
+		iterations *= 2;
+	}
+
+	std::vector<double> samples;
+	samples.reserve(sampleCount);
+	size_t allocationsBefore = AllocationCounter::getAllocationCount();
+	size_t bytesBefore = AllocationCounter::getAllocatedBytes();
+	for (int sample = 0; sample < sampleCount; ++sample) {
+		samples.push_back(runBatch(body, iterations) * 1e6 / iterations);
+	}
+	size_t totalIterations = iterations * samples.size();
+	double allocations = double(AllocationCounter::getAllocationCount() - allocationsBefore) / totalIterations;
+	double bytes = double(AllocationCounter::getAllocatedBytes() - bytesBefore) / totalIterations;
+
+	MicroResult result;
+	result.name = name;
+	result.iterations = iterations;
+	result.samples = samples.size();
+	double sum = 0.0;
+	for (double ns : samples) {
+		sum += ns;
+	}
+	result.meanNs = sum / samples.size();
+	double squares = 0.0;
+	for (double ns : samples) {
+		squares += (ns - result.meanNs) * (ns - result.meanNs);
+	}
+	result.stddevNs = samples.size() > 1 ? std::sqrt(squares / (samples.size() - 1)) : 0.0;
+	std::sort(samples.begin(), samples.end());
+	result.minNs = samples.front();
+	result.medianNs = samples[samples.size() / 2];
+	result.allocationsPerIteration = allocations;
+	result.bytesPerIteration = bytes;
+	return result;
+}
+
+void MicroBenchmark::run(const std::string& filter) {
+	std::printf("%-40s %12s %12s %10s %10s %14s\n", "fixture", "median ns", "min ns", "+- %", "allocs/it", "bytes/it");
+	for (const Fixture& fixture : fixtures) {
+		if (!filter.empty() && fixture.name.find(filter) == std::string::npos) {
+			continue;
+		}
+		MicroResult result = measure(fixture.name, fixture.body);
+		std::printf("%-40s %12.0f %12.0f %10.1f %10.1f %14.0f\n", result.name.c_str(), result.medianNs, result.minNs,
+			result.meanNs > 0.0 ? result.stddevNs / result.meanNs * 100.0 : 0.0,
+			result.allocationsPerIteration, result.bytesPerIteration);
+		std::fflush(stdout);
+		results.push_back(result);
+	}
+}
+
+bool MicroBenchmark::writeJson(const std::string& path) const {
+	std::ofstream file(path);
+	if (!file) {
+		std::cerr << "Failed to write results: " << path << std::endl;
+		return false;
+	}
+	file << "{\n  \"fixtures\": [";
+	for (size_t i = 0; i < results.size(); ++i) {
+		const MicroResult& result = results[i];
+		file << (i > 0 ? ",\n" : "\n") << "    { \"name\": \"" << result.name << "\""
+			<< ", \"iterations\": " << result.iterations
+			<< ", \"samples\": " << result.samples
+			<< ", \"median_ns\": " << result.medianNs
+			<< ", \"mean_ns\": " << result.meanNs
+			<< ", \"min_ns\": " << result.minNs
+			<< ", \"stddev_ns\": " << result.stddevNs
+			<< ", \"allocations_per_iteration\": " << result.allocationsPerIteration
+			<< ", \"bytes_per_iteration\": " << result.bytesPerIteration << " }";
+	}
+	file << "\n  ]\n}\n";
+	std::cout << "Results written to " << path << std::endl;
+	return true;
+}
+
+const std::vector<MicroResult>& MicroBenchmark::getResults() const {
+	return results;
+}